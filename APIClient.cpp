@@ -251,4 +251,18 @@ json DeribitClient::getOrderBook(const string &symbol)
     json payload = {{"instrument_name", symbol}};
 
     return sendRequest("/api/v2/public/get_order_book", payload, "GET");
+}
+
+// Function to retrieve the current server time in milliseconds
+json DeribitClient::getServerTime()
+{
+    return sendRequest("/api/v2/public/get_time", {}, "GET");
+}
+
+// Function to list the live instruments of a currency and kind (e.g. "option")
+json DeribitClient::getInstruments(const string &currency, const string &kind)
+{
+    json payload = {{"currency", currency}, {"kind", kind}, {"expired", false}};
+
+    return sendRequest("/api/v2/public/get_instruments", payload, "GET");
 }
\ No newline at end of file
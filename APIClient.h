@@ -18,6 +18,10 @@ using namespace std::chrono;
 using std::optional;
 using std::nullopt;
 
+// API credentials, defined in APIClient.cpp
+extern const std::string CLIENT_ID;
+extern const std::string CLIENT_SECRET;
+
 class DeribitClient {
 public:
     DeribitClient();
@@ -49,6 +53,8 @@ public:
     json getOpenOrder(const std::string& token="");
     json getOrderState(const std::string& orderid, const std::string& token="");
     json getOrderBook(const std::string& symbol);
+    json getServerTime();
+    json getInstruments(const std::string& currency, const std::string& kind);
 
 private:
     CURL* curl;
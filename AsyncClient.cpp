@@ -0,0 +1,437 @@
+#include "AsyncClient.h"   // Include the AsyncClient header file
+#include "APIClient.h"     // Client credentials shared with the REST client
+#include <iostream>        // For error reporting
+#include <stdexcept>       // For request failures
+#include <boost/asio/co_spawn.hpp>        // Launching coroutines
+#include <boost/asio/detached.hpp>        // Fire-and-forget completion
+#include <boost/asio/redirect_error.hpp>  // Non-throwing waits
+#include <boost/asio/use_awaitable.hpp>   // Coroutine completion token
+#include <boost/beast/websocket/ssl.hpp>  // SSL WebSocket teardown
+
+namespace beast = boost::beast;
+namespace websocket = beast::websocket;
+namespace net = boost::asio;
+namespace ssl = net::ssl;
+using tcp = net::ip::tcp;
+using json = nlohmann::json;
+using net::awaitable;
+using net::use_awaitable;
+
+// State of one in-flight request; the timer is used as a wake-up signal
+struct AsyncWebSocketClient::Pending {
+    explicit Pending(const executor_type &ex) : timer(ex, net::steady_timer::time_point::max()) {}
+
+    net::steady_timer timer;   ///< Cancelled when the response arrives
+    json response;             ///< The response, once received
+    bool done = false;         ///< True once response or error is set
+    std::string error;         ///< Non-empty if the connection failed
+};
+
+// State of one order wait; the timer expires at the deadline and is cancelled on a match
+struct AsyncWebSocketClient::OrderWaiter {
+    OrderWaiter(const executor_type &ex, std::chrono::milliseconds timeout, std::function<bool(const OrderUpdate &)> pred)
+        : timer(ex, timeout), predicate(std::move(pred)) {}
+
+    net::steady_timer timer;                          ///< Deadline, cancelled when a match arrives
+    std::function<bool(const OrderUpdate &)> predicate; ///< Awaited order state
+    OrderUpdate update;                               ///< The matching update, once received
+    bool done = false;                                ///< True once update or error is set
+    std::string error;                                ///< Non-empty if the connection failed
+};
+
+// Constructor for the AsyncWebSocketClient class
+AsyncWebSocketClient::AsyncWebSocketClient(net::io_context &ioc)
+    : strand_(net::make_strand(ioc)), ws_(strand_, ssl_ctx_)
+{
+    ssl_ctx_.set_default_verify_paths(); // Load default SSL certificates for verification
+}
+
+// Resolve, connect and handshake, then start reading
+awaitable<void> AsyncWebSocketClient::connect(const std::string &host, const std::string &port)
+{
+    tcp::resolver resolver(strand_);
+    auto const results = co_await resolver.async_resolve(host, port, use_awaitable);
+    co_await net::async_connect(beast::get_lowest_layer(ws_), results, use_awaitable);
+
+    // Configure SSL settings
+    if (!SSL_set_tlsext_host_name(ws_.next_layer().native_handle(), host.c_str()))
+    {
+        beast::error_code ec{
+            static_cast<int>(::ERR_get_error()),
+            net::error::get_ssl_category()};
+        throw beast::system_error{ec};
+    }
+
+    co_await ws_.next_layer().async_handshake(ssl::stream_base::client, use_awaitable);
+    co_await ws_.async_handshake(host + ":" + port, "/ws/api/v2", use_awaitable);
+    std::cout << "WebSocket connected to " << host << " : " << port << std::endl;
+
+    net::co_spawn(strand_, readLoop(), net::detached);
+}
+
+// Send a request and suspend until the read loop delivers its response
+awaitable<json> AsyncWebSocketClient::request(const std::string &method, json params)
+{
+    int id = next_id_++;
+    json payload = {
+        {"jsonrpc", "2.0"},
+        {"id", id},
+        {"method", method},
+        {"params", params.is_null() ? json::object() : std::move(params)}};
+
+    Pending pending(strand_);
+    pending_.emplace(id, &pending);
+    send(payload.dump());
+
+    while (!pending.done)
+    {
+        beast::error_code ec; // operation_aborted is the wake-up signal
+        co_await pending.timer.async_wait(net::redirect_error(use_awaitable, ec));
+    }
+
+    if (!pending.error.empty())
+        throw std::runtime_error(method + " failed: " + pending.error);
+    co_return std::move(pending.response);
+}
+
+// Suspend until an update of the order satisfies the predicate
+awaitable<OrderUpdate> AsyncWebSocketClient::waitForOrder(const std::string &order_id,
+                                                          std::function<bool(const OrderUpdate &)> predicate,
+                                                          std::chrono::milliseconds timeout)
+{
+    // The update may already have arrived
+    auto cached = last_orders_.find(order_id);
+    if (cached != last_orders_.end() && predicate(cached->second))
+        co_return cached->second;
+
+    OrderWaiter waiter(strand_, timeout, std::move(predicate));
+    order_waiters_.emplace(order_id, &waiter);
+
+    while (!waiter.done)
+    {
+        beast::error_code ec; // operation_aborted is the wake-up signal
+        co_await waiter.timer.async_wait(net::redirect_error(use_awaitable, ec));
+        if (!ec && !waiter.done)
+        {
+            // Deadline reached: unregister before the waiter goes out of scope
+            auto [first, last] = order_waiters_.equal_range(order_id);
+            for (auto it = first; it != last; ++it)
+            {
+                if (it->second == &waiter)
+                {
+                    order_waiters_.erase(it);
+                    break;
+                }
+            }
+            throw std::runtime_error("Timed out waiting for order " + order_id);
+        }
+    }
+
+    if (!waiter.error.empty())
+        throw std::runtime_error("Waiting for order " + order_id + " failed: " + waiter.error);
+    co_return std::move(waiter.update);
+}
+
+// Close the connection gracefully
+awaitable<void> AsyncWebSocketClient::close()
+{
+    if (ws_.is_open())
+        co_await ws_.async_close(websocket::close_code::normal, use_awaitable);
+    std::cout << "WebSocket connection closed." << std::endl;
+}
+
+// Queue a frame; only one write may be outstanding on the stream at a time
+void AsyncWebSocketClient::send(std::string message)
+{
+    outbox_.push_back(std::move(message));
+    if (!writing_)
+    {
+        writing_ = true;
+        net::co_spawn(strand_, writeLoop(), net::detached);
+    }
+}
+
+// Write queued frames until the queue is empty
+awaitable<void> AsyncWebSocketClient::writeLoop()
+{
+    try
+    {
+        while (!outbox_.empty())
+        {
+            co_await ws_.async_write(net::buffer(outbox_.front()), use_awaitable);
+            outbox_.pop_front();
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error during WebSocket write: " << e.what() << std::endl;
+        outbox_.clear();
+        failAll(e.what());
+    }
+    writing_ = false;
+}
+
+// Read frames, completing requests by id and dispatching notifications
+awaitable<void> AsyncWebSocketClient::readLoop()
+{
+    try
+    {
+        beast::flat_buffer buffer; // Reused across frames
+        while (true)
+        {
+            co_await ws_.async_read(buffer, use_awaitable);
+            json message = json::parse(beast::buffers_to_string(buffer.data()));
+            buffer.consume(buffer.size());
+
+            auto id = message.find("id");
+            if (id != message.end() && id->is_number_integer())
+            {
+                auto it = pending_.find(id->get<int>());
+                if (it != pending_.end())
+                {
+                    Pending *pending = it->second;
+                    pending_.erase(it);
+                    pending->response = std::move(message);
+                    pending->done = true;
+                    pending->timer.cancel();
+                }
+                continue;
+            }
+
+            dispatcher_.dispatch(message);
+        }
+    }
+    catch (const beast::system_error &e)
+    {
+        // A closed or cancelled stream is the normal way for the loop to end
+        if (e.code() != websocket::error::closed && e.code() != net::error::operation_aborted)
+            std::cerr << "Error during WebSocket read: " << e.what() << std::endl;
+        failAll(e.what());
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error during WebSocket read: " << e.what() << std::endl;
+        failAll(e.what());
+    }
+}
+
+// Wake every waiting request and order wait with an error
+void AsyncWebSocketClient::failAll(const std::string &reason)
+{
+    for (auto &[id, pending] : pending_)
+    {
+        pending->error = reason;
+        pending->done = true;
+        pending->timer.cancel();
+    }
+    pending_.clear();
+
+    for (auto &[order_id, waiter] : order_waiters_)
+    {
+        waiter->error = reason;
+        waiter->done = true;
+        waiter->timer.cancel();
+    }
+    order_waiters_.clear();
+}
+
+// Remember the latest state of each order and complete the waits it satisfies
+void AsyncWebSocketClient::onOrders(const UserOrdersUpdate &msg)
+{
+    for (const OrderUpdate &order : msg.orders)
+    {
+        auto [cached, inserted] = last_orders_.insert_or_assign(order.order_id, order);
+        if (inserted)
+        {
+            order_ids_.push_back(order.order_id);
+            if (order_ids_.size() > kOrderCacheSize)
+            {
+                last_orders_.erase(order_ids_.front());
+                order_ids_.pop_front();
+            }
+        }
+
+        auto [first, last] = order_waiters_.equal_range(order.order_id);
+        for (auto it = first; it != last;)
+        {
+            OrderWaiter *waiter = it->second;
+            if (!waiter->predicate(order))
+            {
+                ++it;
+                continue;
+            }
+            waiter->update = order;
+            waiter->done = true;
+            waiter->timer.cancel();
+            it = order_waiters_.erase(it);
+        }
+    }
+}
+
+// Constructor for the AsyncDeribitClient class
+AsyncDeribitClient::AsyncDeribitClient(net::io_context &ioc) : ws_(ioc)
+{
+}
+
+awaitable<void> AsyncDeribitClient::connect(const std::string &host, const std::string &port)
+{
+    co_await ws_.connect(host, port);
+}
+
+// Attach the access token to private calls
+awaitable<json> AsyncDeribitClient::privateRequest(const std::string &method, json params, const std::string &token)
+{
+    if (params.is_null())
+        params = json::object();
+    if (!token.empty())
+        params["access_token"] = token;
+    co_return co_await ws_.request(method, std::move(params));
+}
+
+// Authentication to get a token function.
+awaitable<json> AsyncDeribitClient::getAuthToken()
+{
+    json payload = {
+        {"grant_type", "client_credentials"},
+        {"client_id", CLIENT_ID},
+        {"client_secret", CLIENT_SECRET}};
+
+    json response = co_await ws_.request("public/auth", payload);
+
+    if (response.contains("result") && response["result"].contains("access_token"))
+    {
+        co_return response["result"]["access_token"];
+    }
+
+    std::cerr << "Failed to authenticate: " << response.dump(4) << std::endl;
+    co_return json("");
+}
+
+// Place an order
+awaitable<json> AsyncDeribitClient::placeOrder(const std::string &token, const std::string &instrument, const std::string &type, double amount, double price)
+{
+    json payload = {
+        {"instrument_name", instrument},
+        {"type", type},
+        {"amount", amount}};
+
+    if (type == "limit")
+    {
+        payload["price"] = price;
+    }
+
+    co_return co_await privateRequest("private/buy", payload, token);
+}
+
+// Function to modify an existing order on the Deribit platform
+awaitable<json> AsyncDeribitClient::modifyOrder(const std::string &order_id,
+                                                const std::string &token,
+                                                const std::optional<double> &amount,
+                                                const std::optional<double> &contracts,
+                                                const std::optional<double> &price,
+                                                const std::optional<std::string> &advanced,
+                                                const std::optional<bool> &post_only,
+                                                const std::optional<bool> &reduce_only)
+{
+    if (amount && contracts && *amount != *contracts)
+    {
+        std::cerr << "Error: 'amount' and 'contracts' must match if both are provided." << std::endl;
+        co_return json{};
+    }
+
+    if (!amount && !contracts)
+    {
+        std::cerr << "Error: Either 'amount' or 'contracts' must be provided." << std::endl;
+        co_return json{};
+    }
+
+    json payload;
+    payload["order_id"] = order_id;
+    if (amount)
+        payload["amount"] = *amount;
+    if (contracts)
+        payload["contracts"] = *contracts;
+    if (price)
+        payload["price"] = *price;
+    if (advanced)
+        payload["advanced"] = *advanced;
+    if (post_only)
+        payload["post_only"] = *post_only;
+    if (reduce_only)
+        payload["reduce_only"] = *reduce_only;
+
+    co_return co_await privateRequest("private/edit", payload, token);
+}
+
+// Function to place a sell order on the Deribit platform
+awaitable<json> AsyncDeribitClient::sellOrder(const std::string &token,
+                                              const std::string &instrument,
+                                              const std::optional<double> &amount,
+                                              const std::optional<double> &contracts,
+                                              const std::optional<double> &price,
+                                              const std::optional<std::string> &type,
+                                              const std::optional<std::string> &trigger,
+                                              const std::optional<double> &trigger_price)
+{
+    json payload;
+    payload["instrument_name"] = instrument;
+    if (amount)
+        payload["amount"] = *amount;
+    if (contracts)
+        payload["contracts"] = *contracts;
+    if (price)
+        payload["price"] = *price;
+    if (type)
+        payload["type"] = *type;
+    if (trigger)
+        payload["trigger"] = *trigger;
+    if (trigger_price)
+        payload["trigger_price"] = *trigger_price;
+
+    co_return co_await privateRequest("private/sell", payload, token);
+}
+
+// Function to cancel a specific order by its ID
+awaitable<json> AsyncDeribitClient::cancelOrder(const std::string &order_id, const std::string &token)
+{
+    json payload = {
+        {"order_id", order_id}};
+
+    co_return co_await privateRequest("private/cancel", payload, token);
+}
+
+// Function to get all open orders for the authenticated user
+awaitable<json> AsyncDeribitClient::getOpenOrder(const std::string &token)
+{
+    co_return co_await privateRequest("private/get_open_orders", json::object(), token);
+}
+
+// Function to get the state of a specific order by its ID
+awaitable<json> AsyncDeribitClient::getOrderState(const std::string &order_id, const std::string &token)
+{
+    json payload = {{"order_id", order_id}};
+
+    co_return co_await privateRequest("private/get_order_state", payload, token);
+}
+
+// Function to retrieve the order book for a specific instrument
+awaitable<json> AsyncDeribitClient::getOrderBook(const std::string &symbol)
+{
+    json payload = {{"instrument_name", symbol}};
+
+    co_return co_await ws_.request("public/get_order_book", payload);
+}
+
+// Function to wait for an order update, e.g. the fill of an order placed with placeOrder()
+awaitable<OrderUpdate> AsyncDeribitClient::waitForOrder(const std::string &order_id,
+                                                        std::function<bool(const OrderUpdate &)> predicate,
+                                                        std::chrono::milliseconds timeout)
+{
+    co_return co_await ws_.waitForOrder(order_id, std::move(predicate), timeout);
+}
+
+// Function to retrieve the current server time in milliseconds
+awaitable<json> AsyncDeribitClient::getServerTime()
+{
+    co_return co_await ws_.request("public/get_time", json::object());
+}
@@ -0,0 +1,195 @@
+#ifndef ASYNCCLIENT_H
+#define ASYNCCLIENT_H
+
+// Standard C++ headers
+#include <chrono>        // Notification wait timeouts
+#include <deque>         // Outgoing message queue
+#include <functional>    // Typed subscription handlers
+#include <optional>      // Optional order parameters
+#include <string>        // String handling
+#include <type_traits>   // Detecting order subscriptions
+#include <unordered_map> // In-flight requests by id
+#include <utility>       // Required before boost/asio/awaitable.hpp on older Boost releases
+
+// Boost headers for coroutine-based networking, SSL, and WebSocket communication
+#include <boost/asio.hpp>               // Boost.Asio for network programming
+#include <boost/asio/awaitable.hpp>     // Coroutine return type
+#include <boost/asio/ssl.hpp>           // SSL/TLS support in Boost.Asio
+#include <boost/beast/core.hpp>         // Core functionalities of Boost.Beast
+#include <boost/beast/websocket.hpp>    // WebSocket support
+#include <nlohmann/json.hpp>            // JSON parsing and handling
+
+#include "ChannelDispatcher.h"          // Typed channel decoding and dispatch
+
+/**
+ * @class AsyncWebSocketClient
+ * @brief Coroutine-based JSON-RPC client over a single Deribit WebSocket connection.
+ *
+ * Requests are multiplexed over one connection and matched to responses by id, so any
+ * number of coroutines can have requests in flight without a thread each. Order updates
+ * from `user.orders.*` subscriptions can also be awaited, so a workflow such as "place an
+ * order, await the fill, then hedge" reads as straight-line code. All state is confined
+ * to the client's strand: spawn coroutines that use the client on executor().
+ */
+class AsyncWebSocketClient {
+public:
+    using executor_type = boost::asio::strand<boost::asio::io_context::executor_type>;
+
+    /**
+     * @brief Constructs an AsyncWebSocketClient bound to an io_context.
+     * @param ioc The io_context that runs the client; may be run from one or more threads.
+     */
+    explicit AsyncWebSocketClient(boost::asio::io_context& ioc);
+
+    /// The strand on which coroutines using this client must run.
+    executor_type executor() const { return strand_; }
+
+    /**
+     * @brief Connects, performs the SSL and WebSocket handshakes and starts the read loop.
+     * @param host The WebSocket server address.
+     * @param port The port number to connect to.
+     */
+    boost::asio::awaitable<void> connect(const std::string& host, const std::string& port);
+
+    /**
+     * @brief Sends a JSON-RPC request and waits for its response.
+     * @param method The JSON-RPC method (e.g. `private/buy`).
+     * @param params The request parameters.
+     * @return The full JSON-RPC response, including `result` or `error`.
+     * @throws std::runtime_error if the connection fails before the response arrives.
+     */
+    boost::asio::awaitable<nlohmann::json> request(const std::string& method, nlohmann::json params);
+
+    /**
+     * @brief Subscribes to a channel and routes its notifications to a typed handler.
+     * @tparam Msg The message type of the channel family (e.g. BookUpdate for `book.*`).
+     * @param channel The channel name.
+     * @param accessToken The authentication token required for private subscriptions.
+     * @param handler Invoked on the client's strand with each decoded message; may be empty
+     *        for `user.orders.*` channels that are only used through waitForOrder().
+     * @return The subscription response.
+     */
+    template <typename Msg>
+    boost::asio::awaitable<nlohmann::json> subscribe(const std::string& channel, const std::string& accessToken,
+                                                     std::function<void(const Msg&)> handler)
+    {
+        if constexpr (std::is_same_v<Msg, UserOrdersUpdate>)
+        {
+            // Order updates also complete waitForOrder() calls
+            handler = [this, handler = std::move(handler)](const UserOrdersUpdate& msg) {
+                onOrders(msg);
+                if (handler)
+                    handler(msg);
+            };
+        }
+        dispatcher_.on<Msg>(channel, std::move(handler));
+        nlohmann::json params = {{"access_token", accessToken}, {"channels", {channel}}};
+        co_return co_await request("private/subscribe", std::move(params));
+    }
+
+    /**
+     * @brief Waits for an update of an order that satisfies a predicate.
+     *
+     * Requires a `user.orders.*` subscription covering the order. The latest update of
+     * each recent order is kept, so an update that arrived before the call (e.g. while
+     * the placing coroutine was resuming) still completes the wait.
+     * @param order_id The order to watch.
+     * @param predicate Returns true for the awaited state, e.g. `order_state == "filled"`.
+     * @param timeout How long to wait.
+     * @return The first matching update.
+     * @throws std::runtime_error on timeout or if the connection fails.
+     */
+    boost::asio::awaitable<OrderUpdate> waitForOrder(const std::string& order_id,
+                                                     std::function<bool(const OrderUpdate&)> predicate,
+                                                     std::chrono::milliseconds timeout = std::chrono::seconds(30));
+
+    /**
+     * @brief Closes the WebSocket connection gracefully.
+     */
+    boost::asio::awaitable<void> close();
+
+private:
+    struct Pending;
+    struct OrderWaiter;
+
+    /// Number of recent orders whose latest update is kept for waitForOrder().
+    static constexpr size_t kOrderCacheSize = 4096;
+
+    boost::asio::awaitable<void> readLoop();   ///< Completes requests and dispatches notifications
+    boost::asio::awaitable<void> writeLoop();  ///< Drains the outgoing queue one frame at a time
+    void send(std::string message);            ///< Queues a frame and starts the writer if idle
+    void failAll(const std::string& reason);   ///< Wakes every in-flight request with an error
+    void onOrders(const UserOrdersUpdate& msg); ///< Records order updates and wakes matching waiters
+
+    executor_type strand_;                                  ///< Serialises all client state
+    boost::asio::ssl::context ssl_ctx_{boost::asio::ssl::context::tlsv12_client}; ///< SSL context
+    boost::beast::websocket::stream<boost::asio::ssl::stream<boost::asio::ip::tcp::socket>> ws_; ///< WebSocket stream
+    ChannelDispatcher dispatcher_;                          ///< Channel-to-typed-handler routing
+    std::unordered_map<int, Pending*> pending_;             ///< In-flight requests by id
+    std::unordered_multimap<std::string, OrderWaiter*> order_waiters_; ///< Order waits by order id
+    std::unordered_map<std::string, OrderUpdate> last_orders_; ///< Latest update of recent orders
+    std::deque<std::string> order_ids_;                     ///< Cached order ids, oldest first
+    std::deque<std::string> outbox_;                        ///< Frames waiting to be written
+    bool writing_ = false;                                  ///< True while writeLoop() is running
+    int next_id_ = 1;                                       ///< Next JSON-RPC request id
+};
+
+/**
+ * @class AsyncDeribitClient
+ * @brief Awaitable counterparts of the DeribitClient operations.
+ *
+ * Calls are sent as JSON-RPC over an AsyncWebSocketClient and return the same response
+ * documents as the REST client. Spawn workflows on executor().
+ */
+class AsyncDeribitClient {
+public:
+    explicit AsyncDeribitClient(boost::asio::io_context& ioc);
+
+    /// The strand on which coroutines using this client must run.
+    AsyncWebSocketClient::executor_type executor() const { return ws_.executor(); }
+
+    /// The underlying WebSocket client, e.g. for subscriptions.
+    AsyncWebSocketClient& webSocket() { return ws_; }
+
+    boost::asio::awaitable<void> connect(const std::string& host = "test.deribit.com", const std::string& port = "443");
+    boost::asio::awaitable<nlohmann::json> getAuthToken();
+    boost::asio::awaitable<nlohmann::json> placeOrder(const std::string& token = "", const std::string& instrument = "",
+                                                      const std::string& type = "", double amount = 0.0, double price = 0.0);
+    boost::asio::awaitable<nlohmann::json> modifyOrder(const std::string& order_id,
+        const std::string& token = "",
+        const std::optional<double>& amount = std::nullopt,
+        const std::optional<double>& contracts = std::nullopt,
+        const std::optional<double>& price = std::nullopt,
+        const std::optional<std::string>& advanced = std::nullopt,
+        const std::optional<bool>& post_only = std::nullopt,
+        const std::optional<bool>& reduce_only = std::nullopt);
+
+    boost::asio::awaitable<nlohmann::json> sellOrder(const std::string& token = "",
+        const std::string& instrument = "",
+        const std::optional<double>& amount = std::nullopt,
+        const std::optional<double>& contracts = std::nullopt,
+        const std::optional<double>& price = std::nullopt,
+        const std::optional<std::string>& type = std::nullopt,
+        const std::optional<std::string>& trigger = std::nullopt,
+        const std::optional<double>& trigger_price = std::nullopt);
+
+    boost::asio::awaitable<nlohmann::json> cancelOrder(const std::string& orderid, const std::string& token = "");
+    boost::asio::awaitable<nlohmann::json> getOpenOrder(const std::string& token = "");
+    boost::asio::awaitable<nlohmann::json> getOrderState(const std::string& orderid, const std::string& token = "");
+    boost::asio::awaitable<nlohmann::json> getOrderBook(const std::string& symbol);
+    boost::asio::awaitable<nlohmann::json> getServerTime();
+
+    /// Waits for an order update matching a predicate; see AsyncWebSocketClient::waitForOrder().
+    boost::asio::awaitable<OrderUpdate> waitForOrder(const std::string& order_id,
+                                                     std::function<bool(const OrderUpdate&)> predicate,
+                                                     std::chrono::milliseconds timeout = std::chrono::seconds(30));
+
+private:
+    /// Sends a private method, attaching the access token when one is given.
+    boost::asio::awaitable<nlohmann::json> privateRequest(const std::string& method, nlohmann::json params,
+                                                          const std::string& token);
+
+    AsyncWebSocketClient ws_;   ///< JSON-RPC transport
+};
+
+#endif // ASYNCCLIENT_H
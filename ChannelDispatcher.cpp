@@ -0,0 +1,166 @@
+#include "ChannelDispatcher.h" // Include the ChannelDispatcher header file
+#include <algorithm>           // For std::max
+#include <limits>              // For quiet NaN defaults
+#include <string>              // String handling
+#include <nlohmann/json.hpp>   // JSON handling using the nlohmann library
+
+using json = nlohmann::json; // Alias for JSON type from nlohmann library
+
+// Read a numeric field, falling back to a default when it is missing or null
+static double numberField(const json &obj, const char *key, double fallback = 0.0)
+{
+    auto it = obj.find(key);
+    return (it != obj.end() && it->is_number()) ? it->get<double>() : fallback;
+}
+
+// Read an integer field, falling back to 0 when it is missing or null
+static long long integerField(const json &obj, const char *key)
+{
+    auto it = obj.find(key);
+    return (it != obj.end() && it->is_number()) ? it->get<long long>() : 0;
+}
+
+// Read a string field, falling back to an empty string when it is missing
+static std::string stringField(const json &obj, const char *key)
+{
+    auto it = obj.find(key);
+    return (it != obj.end() && it->is_string()) ? it->get<std::string>() : std::string();
+}
+
+// Decode one side of the book: either [action, price, amount] or [price, amount] entries
+static void decodeLevels(const json &side, std::vector<PriceLevel> &out)
+{
+    out.reserve(side.size());
+    for (const json &level : side)
+    {
+        if (level.size() == 3)
+        {
+            const std::string &action = level[0].get_ref<const std::string &>();
+            LevelAction kind = action == "new"      ? LevelAction::New
+                               : action == "delete" ? LevelAction::Delete
+                                                    : LevelAction::Change;
+            out.push_back({kind, level[1].get<double>(), level[2].get<double>()});
+        }
+        else if (level.size() == 2)
+        {
+            out.push_back({LevelAction::New, level[0].get<double>(), level[1].get<double>()});
+        }
+    }
+}
+
+// Decode a book.* notification
+BookUpdate ChannelTraits<BookUpdate>::decode(const json &data)
+{
+    BookUpdate msg;
+    msg.instrument_name = stringField(data, "instrument_name");
+    msg.timestamp = integerField(data, "timestamp");
+    msg.change_id = integerField(data, "change_id");
+    msg.prev_change_id = integerField(data, "prev_change_id");
+    if (auto it = data.find("bids"); it != data.end())
+        decodeLevels(*it, msg.bids);
+    if (auto it = data.find("asks"); it != data.end())
+        decodeLevels(*it, msg.asks);
+    return msg;
+}
+
+// Decode a trades.* notification (always an array of trades)
+TradesUpdate ChannelTraits<TradesUpdate>::decode(const json &data)
+{
+    TradesUpdate msg;
+    msg.trades.reserve(data.size());
+    for (const json &t : data)
+    {
+        Trade trade;
+        trade.instrument_name = stringField(t, "instrument_name");
+        trade.trade_id = stringField(t, "trade_id");
+        trade.trade_seq = integerField(t, "trade_seq");
+        trade.timestamp = integerField(t, "timestamp");
+        trade.price = numberField(t, "price");
+        trade.amount = numberField(t, "amount");
+        trade.buy = stringField(t, "direction") == "buy";
+        msg.trades.push_back(std::move(trade));
+    }
+    return msg;
+}
+
+// Decode a ticker.* notification
+TickerUpdate ChannelTraits<TickerUpdate>::decode(const json &data)
+{
+    constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+
+    TickerUpdate msg;
+    msg.instrument_name = stringField(data, "instrument_name");
+    msg.timestamp = integerField(data, "timestamp");
+    msg.best_bid_price = numberField(data, "best_bid_price");
+    msg.best_bid_amount = numberField(data, "best_bid_amount");
+    msg.best_ask_price = numberField(data, "best_ask_price");
+    msg.best_ask_amount = numberField(data, "best_ask_amount");
+    msg.last_price = numberField(data, "last_price");
+    msg.mark_price = numberField(data, "mark_price");
+    msg.index_price = numberField(data, "index_price");
+    msg.underlying_price = numberField(data, "underlying_price", nan);
+    msg.mark_iv = numberField(data, "mark_iv", nan);
+    msg.interest_rate = numberField(data, "interest_rate", nan);
+    return msg;
+}
+
+// Decode a single order object from a user.orders.* notification
+static OrderUpdate decodeOrder(const json &o)
+{
+    OrderUpdate order;
+    order.order_id = stringField(o, "order_id");
+    order.instrument_name = stringField(o, "instrument_name");
+    order.order_state = stringField(o, "order_state");
+    order.direction = stringField(o, "direction");
+    order.last_update_timestamp = integerField(o, "last_update_timestamp");
+    order.price = numberField(o, "price");
+    order.amount = numberField(o, "amount");
+    order.filled_amount = numberField(o, "filled_amount");
+    order.average_price = numberField(o, "average_price");
+    return order;
+}
+
+// Decode a user.orders.* notification: raw channels carry one order, batched ones an array
+UserOrdersUpdate ChannelTraits<UserOrdersUpdate>::decode(const json &data)
+{
+    UserOrdersUpdate msg;
+    if (data.is_array())
+    {
+        msg.orders.reserve(data.size());
+        for (const json &o : data)
+            msg.orders.push_back(decodeOrder(o));
+    }
+    else
+    {
+        msg.orders.push_back(decodeOrder(data));
+    }
+    return msg;
+}
+
+// Latest update time across the orders in the notification
+long long ChannelTraits<UserOrdersUpdate>::timestamp(const UserOrdersUpdate &msg)
+{
+    long long latest = 0;
+    for (const OrderUpdate &order : msg.orders)
+        latest = std::max(latest, order.last_update_timestamp);
+    return latest;
+}
+
+// Route a subscription notification to its typed handler
+std::optional<DispatchResult> ChannelDispatcher::dispatch(const json &message) const
+{
+    auto params = message.find("params");
+    if (params == message.end() || !params->is_object())
+        return std::nullopt; // Not a notification
+
+    auto channel = params->find("channel");
+    auto data = params->find("data");
+    if (channel == params->end() || data == params->end() || !channel->is_string())
+        return std::nullopt;
+
+    auto it = index_.find(channel->get_ref<const std::string &>());
+    if (it == index_.end())
+        return std::nullopt; // No handler registered for this channel
+
+    return DispatchResult{slots_[it->second](*data), it->second};
+}
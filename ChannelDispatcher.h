@@ -0,0 +1,210 @@
+#ifndef CHANNELDISPATCHER_H
+#define CHANNELDISPATCHER_H
+
+// Standard C++ headers
+#include <functional>    // Type-erased handler slots
+#include <optional>      // Optional dispatch result
+#include <stdexcept>     // Invalid channel errors
+#include <string>        // String handling
+#include <string_view>   // Channel prefixes
+#include <unordered_map> // Channel-to-slot index
+#include <utility>       // std::move
+#include <vector>        // Slot table and message payloads
+#include <nlohmann/json.hpp> // JSON parsing and handling
+
+using json = nlohmann::json;
+
+/**
+ * @brief Action carried by a single order book level.
+ */
+enum class LevelAction { New, Change, Delete };
+
+/**
+ * @brief One price level of a `book.*` notification.
+ */
+struct PriceLevel {
+    LevelAction action;  ///< Whether the level was added, changed or removed
+    double price;        ///< Level price
+    double amount;       ///< Level amount (0 for deletions)
+};
+
+/**
+ * @brief Decoded `book.{instrument}.{interval}` notification.
+ */
+struct BookUpdate {
+    std::string instrument_name;   ///< Instrument the update belongs to
+    long long timestamp = 0;       ///< Server timestamp (ms)
+    long long change_id = 0;       ///< Sequence number of this update
+    long long prev_change_id = 0;  ///< Sequence number of the previous update (0 for snapshots)
+    std::vector<PriceLevel> bids;  ///< Bid level changes
+    std::vector<PriceLevel> asks;  ///< Ask level changes
+};
+
+/**
+ * @brief A single public trade.
+ */
+struct Trade {
+    std::string instrument_name;   ///< Instrument that traded
+    std::string trade_id;          ///< Exchange trade id
+    long long trade_seq = 0;       ///< Per-instrument trade sequence number
+    long long timestamp = 0;       ///< Server timestamp (ms)
+    double price = 0.0;            ///< Trade price
+    double amount = 0.0;           ///< Trade amount
+    bool buy = false;              ///< True if the aggressor was a buyer
+};
+
+/**
+ * @brief Decoded `trades.{instrument}.{interval}` notification.
+ */
+struct TradesUpdate {
+    std::vector<Trade> trades;     ///< Trades in the notification, oldest first
+};
+
+/**
+ * @brief Decoded `ticker.{instrument}.{interval}` notification.
+ * Option-only fields are NaN for other instrument kinds.
+ */
+struct TickerUpdate {
+    std::string instrument_name;   ///< Instrument the ticker belongs to
+    long long timestamp = 0;       ///< Server timestamp (ms)
+    double best_bid_price = 0.0;   ///< Best bid price
+    double best_bid_amount = 0.0;  ///< Best bid amount
+    double best_ask_price = 0.0;   ///< Best ask price
+    double best_ask_amount = 0.0;  ///< Best ask amount
+    double last_price = 0.0;       ///< Last traded price
+    double mark_price = 0.0;       ///< Mark price
+    double index_price = 0.0;      ///< Index price
+    double underlying_price = 0.0; ///< Underlying (forward) price, options only
+    double mark_iv = 0.0;          ///< Mark implied volatility in percent, options only
+    double interest_rate = 0.0;    ///< Interest rate used for pricing, options only
+};
+
+/**
+ * @brief A single order update on a private `user.orders.*` channel.
+ */
+struct OrderUpdate {
+    std::string order_id;          ///< Exchange order id
+    std::string instrument_name;   ///< Instrument the order is on
+    std::string order_state;       ///< open, filled, rejected, cancelled, untriggered
+    std::string direction;         ///< buy or sell
+    long long last_update_timestamp = 0; ///< Server timestamp of the update (ms)
+    double price = 0.0;            ///< Order price
+    double amount = 0.0;           ///< Order amount
+    double filled_amount = 0.0;    ///< Filled amount
+    double average_price = 0.0;    ///< Average fill price
+};
+
+/**
+ * @brief Decoded `user.orders.{instrument}.{interval}` notification.
+ */
+struct UserOrdersUpdate {
+    std::vector<OrderUpdate> orders; ///< Orders in the notification
+};
+
+/**
+ * @brief Per-message-type channel description.
+ * Each specialisation provides the channel family prefix, the decoder and the
+ * server timestamp used for latency measurement.
+ */
+template <typename Msg>
+struct ChannelTraits;
+
+template <>
+struct ChannelTraits<BookUpdate> {
+    static constexpr std::string_view prefix = "book.";
+    static BookUpdate decode(const json& data);
+    static long long timestamp(const BookUpdate& msg) { return msg.timestamp; }
+};
+
+template <>
+struct ChannelTraits<TradesUpdate> {
+    static constexpr std::string_view prefix = "trades.";
+    static TradesUpdate decode(const json& data);
+    static long long timestamp(const TradesUpdate& msg) { return msg.trades.empty() ? 0 : msg.trades.back().timestamp; }
+};
+
+template <>
+struct ChannelTraits<TickerUpdate> {
+    static constexpr std::string_view prefix = "ticker.";
+    static TickerUpdate decode(const json& data);
+    static long long timestamp(const TickerUpdate& msg) { return msg.timestamp; }
+};
+
+template <>
+struct ChannelTraits<UserOrdersUpdate> {
+    static constexpr std::string_view prefix = "user.orders.";
+    static UserOrdersUpdate decode(const json& data);
+    static long long timestamp(const UserOrdersUpdate& msg);
+};
+
+/**
+ * @brief Outcome of dispatching a notification to a registered channel.
+ */
+struct DispatchResult {
+    long long timestamp;   ///< Server timestamp (ms) of the decoded message
+    size_t slot;           ///< Index of the channel the message was routed to
+};
+
+/**
+ * @class ChannelDispatcher
+ * @brief Routes subscription notifications to typed handlers.
+ *
+ * The decoder for a channel is bound when the handler is registered, so each frame
+ * costs one index lookup on the channel name and one call into a typed handler.
+ */
+class ChannelDispatcher {
+public:
+    /**
+     * @brief Registers a typed handler for a channel.
+     * @tparam Msg The message type; its ChannelTraits prefix must match the channel.
+     * @param channel Full channel name (e.g. `book.BTC-PERPETUAL.100ms`).
+     * @param handler Invoked with each decoded message.
+     * @throws std::invalid_argument if the channel does not belong to Msg's family.
+     */
+    template <typename Msg>
+    void on(const std::string& channel, std::function<void(const Msg&)> handler)
+    {
+        if (channel.compare(0, ChannelTraits<Msg>::prefix.size(), ChannelTraits<Msg>::prefix) != 0)
+            throw std::invalid_argument("Channel " + channel + " does not match " +
+                                        std::string(ChannelTraits<Msg>::prefix) + "*");
+
+        Slot slot = [handler = std::move(handler)](const json& data) {
+            Msg msg = ChannelTraits<Msg>::decode(data);
+            handler(msg);
+            return ChannelTraits<Msg>::timestamp(msg);
+        };
+
+        auto it = index_.find(channel);
+        if (it != index_.end())
+        {
+            slots_[it->second] = std::move(slot); // Re-subscribing replaces the handler
+            return;
+        }
+        index_.emplace(channel, slots_.size());
+        slots_.push_back(std::move(slot));
+        channels_.push_back(channel);
+    }
+
+    /**
+     * @brief Dispatches a parsed frame to the handler registered for its channel.
+     * @param message The full JSON-RPC frame.
+     * @return The server timestamp (ms) and channel slot of the decoded message, or
+     *         nullopt if the frame is not a notification for a registered channel.
+     */
+    std::optional<DispatchResult> dispatch(const json& message) const;
+
+    /// Number of registered channels; slots are numbered from 0.
+    size_t slotCount() const { return slots_.size(); }
+
+    /// Channel name registered in a slot.
+    const std::string& channelName(size_t slot) const { return channels_[slot]; }
+
+private:
+    using Slot = std::function<long long(const json&)>;
+
+    std::vector<Slot> slots_;                         ///< Decoder and handler per channel
+    std::vector<std::string> channels_;               ///< Channel name per slot
+    std::unordered_map<std::string, size_t> index_;   ///< Channel name to slot index
+};
+
+#endif // CHANNELDISPATCHER_H
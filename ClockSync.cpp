@@ -0,0 +1,165 @@
+#include "ClockSync.h"   // Include the ClockSync header file
+#include "APIClient.h"   // REST client used for public/get_time
+#include <algorithm>     // For sorting samples by RTT
+#include <chrono>        // Steady and system clocks
+#include <vector>        // Filtered sample set
+#include <nlohmann/json.hpp> // For JSON handling using the nlohmann library
+
+using json = nlohmann::json; // Alias for JSON type from nlohmann library
+using namespace std::chrono; // For time utilities
+
+// Minimum time span covered by the filtered samples before drift is estimated
+static constexpr int64_t kMinDriftSpanNs = 10'000'000'000LL;
+
+// Upper bound on the fitted drift; anything larger is treated as noise
+static constexpr double kMaxDrift = 500e-6;
+
+// Constructor: anchor the monotonic clock to the current wall-clock time
+ClockSync::ClockSync()
+    : anchor_wall_ns_(duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count()),
+      anchor_mono_ns_(monotonicNowNs())
+{
+}
+
+// Read the monotonic clock in nanoseconds
+int64_t ClockSync::monotonicNowNs()
+{
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+// Wall-clock time derived from the monotonic clock
+int64_t ClockSync::localNowNs() const
+{
+    return anchor_wall_ns_ + (monotonicNowNs() - anchor_mono_ns_);
+}
+
+// Record one NTP-style round trip: the server time is assumed to sit at the midpoint
+void ClockSync::addSample(int64_t send_ns, int64_t server_time_ms, int64_t recv_ns)
+{
+    if (recv_ns < send_ns)
+        return; // Ignore malformed samples
+
+    Sample sample;
+    sample.send_ns = send_ns;
+    sample.recv_ns = recv_ns;
+    sample.rtt_ns = recv_ns - send_ns;
+    sample.offset_ns = server_time_ms * 1'000'000LL - (send_ns + sample.rtt_ns / 2);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    samples_.push_back(sample);
+    if (samples_.size() > kMaxSamples)
+        samples_.pop_front(); // Keep the window bounded
+    refit();
+}
+
+// Sample the server clock over REST
+int ClockSync::sampleRest(DeribitClient &client, int count)
+{
+    int recorded = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        int64_t send_ns = localNowNs();
+        json response = client.getServerTime();
+        int64_t recv_ns = localNowNs();
+
+        if (response.contains("result") && response["result"].is_number_integer())
+        {
+            addSample(send_ns, response["result"].get<int64_t>(), recv_ns);
+            ++recorded;
+        }
+    }
+    return recorded;
+}
+
+// Fit offset and drift over the lowest-RTT samples in the window
+void ClockSync::refit()
+{
+    std::vector<Sample> best(samples_.begin(), samples_.end());
+    std::sort(best.begin(), best.end(),
+              [](const Sample &a, const Sample &b) { return a.rtt_ns < b.rtt_ns; });
+
+    min_rtt_ns_ = best.front().rtt_ns;
+
+    // Samples with a high RTT are likely to carry asymmetric queueing delay; drop them
+    size_t keep = std::max<size_t>(1, static_cast<size_t>(best.size() * kRttFilterRatio));
+    best.resize(keep);
+
+    // Midpoint of each sample in local time, relative to the first to keep values small
+    int64_t base = best.front().send_ns + best.front().rtt_ns / 2;
+    double mean_t = 0.0, mean_o = 0.0;
+    int64_t lo = base, hi = base;
+    for (const Sample &s : best)
+    {
+        int64_t mid = s.send_ns + s.rtt_ns / 2;
+        mean_t += static_cast<double>(mid - base);
+        mean_o += static_cast<double>(s.offset_ns);
+        lo = std::min(lo, mid);
+        hi = std::max(hi, mid);
+    }
+    mean_t /= keep;
+    mean_o /= keep;
+
+    // Least-squares slope of offset over local time gives the drift
+    double drift = 0.0;
+    if (keep >= 2 && hi - lo >= kMinDriftSpanNs)
+    {
+        double num = 0.0, den = 0.0;
+        for (const Sample &s : best)
+        {
+            double dt = static_cast<double>(s.send_ns + s.rtt_ns / 2 - base) - mean_t;
+            num += dt * (static_cast<double>(s.offset_ns) - mean_o);
+            den += dt * dt;
+        }
+        if (den > 0.0)
+            drift = std::clamp(num / den, -kMaxDrift, kMaxDrift);
+    }
+
+    ref_local_ns_ = base + static_cast<int64_t>(mean_t);
+    ref_offset_ns_ = static_cast<int64_t>(mean_o);
+    drift_ = drift;
+}
+
+// Offset extrapolated to the given local time
+int64_t ClockSync::offsetNs(int64_t local_ns) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (samples_.empty())
+        return 0;
+    return ref_offset_ns_ + static_cast<int64_t>(drift_ * static_cast<double>(local_ns - ref_local_ns_));
+}
+
+// Convert a server timestamp to local time
+int64_t ClockSync::serverToLocalNs(int64_t server_time_ms, int64_t local_ns) const
+{
+    return server_time_ms * 1'000'000LL - offsetNs(local_ns);
+}
+
+// Exchange-to-client delay with the clock offset removed
+int64_t ClockSync::oneWayDelayNs(int64_t server_time_ms, int64_t recv_ns) const
+{
+    return recv_ns - serverToLocalNs(server_time_ms, recv_ns);
+}
+
+double ClockSync::driftPpm() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return drift_ * 1e6;
+}
+
+int64_t ClockSync::minRttNs() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return min_rtt_ns_;
+}
+
+bool ClockSync::synced() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return !samples_.empty();
+}
+
+size_t ClockSync::sampleCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return samples_.size();
+}
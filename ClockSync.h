@@ -0,0 +1,120 @@
+#ifndef CLOCKSYNC_H
+#define CLOCKSYNC_H
+
+// Standard C++ headers
+#include <chrono>        // Steady and system clocks
+#include <cstdint>       // Fixed-width integer types
+#include <deque>         // Sliding window of sync samples
+#include <mutex>         // Mutex for thread synchronization
+
+class DeribitClient;
+
+/**
+ * @class ClockSync
+ * @brief Estimates the offset and drift between the local clock and the Deribit server clock.
+ *
+ * Local times are taken from a monotonic nanosecond clock anchored once to the wall clock,
+ * so they never jump when the system time is adjusted. Each `public/get_time` round trip
+ * yields an NTP-style sample; only the samples with the lowest round-trip time are trusted
+ * when fitting the offset and drift.
+ */
+class ClockSync {
+public:
+    /// Maximum number of samples kept in the sliding window.
+    static constexpr size_t kMaxSamples = 64;
+
+    /// Fraction of the window (lowest RTT first) used for the offset and drift fit.
+    static constexpr double kRttFilterRatio = 0.25;
+
+    /**
+     * @brief A single round-trip measurement against the server clock.
+     */
+    struct Sample {
+        int64_t send_ns;     ///< Local time (ns) when the request was sent
+        int64_t recv_ns;     ///< Local time (ns) when the response was received
+        int64_t offset_ns;   ///< Estimated server minus local time (ns) at the midpoint
+        int64_t rtt_ns;      ///< Round-trip time (ns)
+    };
+
+    /**
+     * @brief Constructs a ClockSync object and anchors the monotonic clock to the wall clock.
+     */
+    ClockSync();
+
+    /**
+     * @brief Reads the monotonic clock.
+     * @return Nanoseconds since an arbitrary, steady epoch.
+     */
+    static int64_t monotonicNowNs();
+
+    /**
+     * @brief Reads the local clock as wall time derived from the monotonic clock.
+     * @return Nanoseconds since the Unix epoch, immune to system clock adjustments.
+     */
+    int64_t localNowNs() const;
+
+    /**
+     * @brief Adds a round-trip sample.
+     * @param send_ns Local time (ns) before the request was sent.
+     * @param server_time_ms Server timestamp (ms) returned by `public/get_time`.
+     * @param recv_ns Local time (ns) after the response was received.
+     */
+    void addSample(int64_t send_ns, int64_t server_time_ms, int64_t recv_ns);
+
+    /**
+     * @brief Samples the server clock over REST using `public/get_time`.
+     * @param client The REST client used to send the requests.
+     * @param count Number of round trips to perform.
+     * @return The number of samples that were recorded successfully.
+     */
+    int sampleRest(DeribitClient& client, int count);
+
+    /**
+     * @brief Returns the estimated server minus local offset at a given local time.
+     * @param local_ns Local time (ns), as returned by localNowNs().
+     */
+    int64_t offsetNs(int64_t local_ns) const;
+
+    /**
+     * @brief Converts a server timestamp to the local timebase.
+     * @param server_time_ms Server timestamp in milliseconds.
+     * @param local_ns Approximate local time of the event, used to apply drift.
+     * @return The equivalent local time in nanoseconds.
+     */
+    int64_t serverToLocalNs(int64_t server_time_ms, int64_t local_ns) const;
+
+    /**
+     * @brief Computes the one-way delay of a message with offset correction applied.
+     * @param server_time_ms Server timestamp carried by the message (ms).
+     * @param recv_ns Local receive time (ns), as returned by localNowNs().
+     * @return The corrected exchange-to-client delay in nanoseconds.
+     */
+    int64_t oneWayDelayNs(int64_t server_time_ms, int64_t recv_ns) const;
+
+    /// Estimated drift of the local clock relative to the server, in parts per million.
+    double driftPpm() const;
+
+    /// Lowest round-trip time seen in the current window (ns), or 0 if none.
+    int64_t minRttNs() const;
+
+    /// True once at least one sample has been recorded.
+    bool synced() const;
+
+    /// Number of samples in the current window.
+    size_t sampleCount() const;
+
+private:
+    void refit();                          ///< Recomputes offset and drift; mutex must be held
+
+    int64_t anchor_wall_ns_;               ///< Wall-clock time at construction (ns)
+    int64_t anchor_mono_ns_;               ///< Monotonic time at construction (ns)
+
+    mutable std::mutex mutex_;             ///< Guards the samples and the fitted estimate
+    std::deque<Sample> samples_;           ///< Sliding window of samples
+    int64_t ref_local_ns_ = 0;             ///< Local time the fitted offset refers to
+    int64_t ref_offset_ns_ = 0;            ///< Fitted offset at ref_local_ns_
+    double drift_ = 0.0;                   ///< Fitted drift (ns of offset per ns of local time)
+    int64_t min_rtt_ns_ = 0;               ///< Lowest RTT in the window
+};
+
+#endif // CLOCKSYNC_H
@@ -0,0 +1,103 @@
+#ifndef METEREDSTREAM_H
+#define METEREDSTREAM_H
+
+// Standard C++ headers
+#include <cstdint>       // Fixed-width integer types
+#include <utility>       // std::forward
+
+// Boost headers
+#include <boost/beast/core/error.hpp>   // Error codes
+#include <boost/beast/core/role.hpp>    // Client/server role for teardown
+
+#include "ClockSync.h"                  // Monotonic nanosecond clock
+
+/**
+ * @class MeteredStream
+ * @brief Synchronous stream layer that counts the bytes passing through it.
+ *
+ * Placed between a WebSocket stream and its transport, it sees frames exactly as they
+ * travel on the wire (compressed, before permessage-deflate inflation) and records
+ * when the last read completed, so the time a read spends decoding after the final
+ * bytes arrived can be measured.
+ */
+template <class NextLayer>
+class MeteredStream {
+public:
+    using next_layer_type = NextLayer;
+    using executor_type = typename NextLayer::executor_type;
+
+    /**
+     * @brief Constructs the next layer in place.
+     */
+    template <class... Args>
+    explicit MeteredStream(Args&&... args) : next_(std::forward<Args>(args)...) {}
+
+    next_layer_type& next_layer() { return next_; }
+    const next_layer_type& next_layer() const { return next_; }
+    executor_type get_executor() { return next_.get_executor(); }
+
+    template <class MutableBufferSequence>
+    std::size_t read_some(const MutableBufferSequence& buffers)
+    {
+        std::size_t n = next_.read_some(buffers);
+        recordRead(n);
+        return n;
+    }
+
+    template <class MutableBufferSequence>
+    std::size_t read_some(const MutableBufferSequence& buffers, boost::beast::error_code& ec)
+    {
+        std::size_t n = next_.read_some(buffers, ec);
+        recordRead(n);
+        return n;
+    }
+
+    template <class ConstBufferSequence>
+    std::size_t write_some(const ConstBufferSequence& buffers)
+    {
+        std::size_t n = next_.write_some(buffers);
+        bytes_written_ += n;
+        return n;
+    }
+
+    template <class ConstBufferSequence>
+    std::size_t write_some(const ConstBufferSequence& buffers, boost::beast::error_code& ec)
+    {
+        std::size_t n = next_.write_some(buffers, ec);
+        bytes_written_ += n;
+        return n;
+    }
+
+    /// Total bytes read from the next layer.
+    uint64_t bytesRead() const { return bytes_read_; }
+
+    /// Total bytes written to the next layer.
+    uint64_t bytesWritten() const { return bytes_written_; }
+
+    /// Monotonic time (ns) at which the last read from the next layer completed.
+    int64_t lastReadNs() const { return last_read_ns_; }
+
+private:
+    void recordRead(std::size_t n)
+    {
+        bytes_read_ += n;
+        last_read_ns_ = ClockSync::monotonicNowNs();
+    }
+
+    NextLayer next_;                 ///< Wrapped transport
+    uint64_t bytes_read_ = 0;        ///< Bytes read so far
+    uint64_t bytes_written_ = 0;     ///< Bytes written so far
+    int64_t last_read_ns_ = 0;       ///< Completion time of the last read
+};
+
+/**
+ * @brief Tears down the transport under a MeteredStream when the WebSocket closes.
+ * Shuts down the SSL layer, like the teardown for a bare SSL stream.
+ */
+template <class NextLayer>
+void teardown(boost::beast::role_type, MeteredStream<NextLayer>& stream, boost::beast::error_code& ec)
+{
+    stream.next_layer().shutdown(ec); // Gracefully shut down the SSL connection
+}
+
+#endif // METEREDSTREAM_H
@@ -0,0 +1,458 @@
+#include "OptionsChain.h"     // Include the OptionsChain header file
+#include "APIClient.h"        // REST client used to list the chain
+#include "WebSocketClient.h"  // WebSocket client for ticker subscriptions
+#include <algorithm>          // For std::min and std::max
+#include <bit>                // For std::bit_cast
+#include <chrono>             // For timing recomputes
+#include <cmath>              // For std::log, std::sqrt and std::isfinite
+#include <condition_variable> // For waking the deferred recompute thread
+#include <iostream>           // For output
+#include <latch>              // For waiting on the worker pool
+#include <limits>             // For quiet NaN
+#include <mutex>              // For sharing the chain between threads
+#include <thread>             // For the deferred recompute thread
+#include <boost/asio/post.hpp> // For submitting work to the pool
+
+using json = nlohmann::json;  // Alias for JSON type from nlohmann library
+
+// Milliseconds per (365-day) year, used for time to expiry
+static constexpr double kMsPerYear = 365.0 * 86'400'000.0;
+
+// Options closer to expiry than this are valued as if this much time were left
+static constexpr int64_t kMinTimeToExpiryMs = 60'000;
+
+// Newton iterations for the implied volatility solve; the start is usually close
+static constexpr int kIvIterations = 8;
+
+// Volatility search bounds
+static constexpr double kMinVol = 1e-3;
+static constexpr double kMaxVol = 10.0;
+
+// A solve is accepted if the model price is within this fraction of the forward
+static constexpr double kPriceTolerance = 1e-6;
+
+// Prices whose time value is below this fraction of the forward do not pin down a volatility
+static constexpr double kMinTimeValue = 1e-5;
+
+// Number of double columns in the kernel work area
+enum WorkColumn { KCol = 0, LogKCol, PhiCol, PriceCol, SolvedCol, VolCol, DeltaCol, GammaCol, VegaCol, ThetaCol, WorkColumnCount };
+
+static constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+// The helpers below avoid library calls and branches so the row loops can be vectorized
+
+// e^x via range reduction to [-ln2/2, ln2/2], a Taylor polynomial and exponent-bit scaling
+static inline double fastExp(double x)
+{
+    constexpr double kLog2e = 1.4426950408889634;
+    constexpr double kLn2Hi = 6.93145751953125e-1;
+    constexpr double kLn2Lo = 1.42860682030941723212e-6;
+    constexpr double kRound = 6755399441055744.0; // 1.5 * 2^52: adding it rounds to an integer
+
+    x = std::min(std::max(x, -700.0), 700.0);
+    double t = x * kLog2e + kRound;
+    double n = t - kRound;
+    double r = (x - n * kLn2Hi) - n * kLn2Lo;
+
+    double p = 1.0 + r * (1.0 + r * (1.0 / 2 + r * (1.0 / 6 + r * (1.0 / 24 + r * (1.0 / 120 + r * (1.0 / 720 +
+               r * (1.0 / 5040 + r * (1.0 / 40320 + r * (1.0 / 362880 + r * (1.0 / 3628800 + r * (1.0 / 39916800)))))))))));
+
+    // The low mantissa bits of t hold n; move n + 1023 into the exponent field
+    uint64_t bits = (std::bit_cast<uint64_t>(t) + 1023) << 52;
+    return p * std::bit_cast<double>(bits);
+}
+
+// Standard normal density
+static inline double normPdf(double x)
+{
+    constexpr double kInvSqrt2Pi = 0.3989422804014327;
+    return kInvSqrt2Pi * fastExp(-0.5 * x * x);
+}
+
+// Standard normal distribution (Abramowitz & Stegun 26.2.17, |error| < 7.5e-8)
+static inline double normCdf(double x)
+{
+    double ax = std::abs(x);
+    double t = 1.0 / (1.0 + 0.2316419 * ax);
+    double poly = t * (0.319381530 + t * (-0.356563782 + t * (1.781477937 + t * (-1.821255978 + t * 1.330274429))));
+    double upper = 1.0 - normPdf(ax) * poly;
+    return x >= 0.0 ? upper : 1.0 - upper;
+}
+
+// Newton solve for Black-76 implied volatility, one pass over all rows per iteration.
+// vol holds the starting points on entry and the clamped solutions on exit.
+static void solveVolatility(size_t m, const double *__restrict K, const double *__restrict lnK,
+                            const double *__restrict phi, const double *__restrict target, double *__restrict vol,
+                            double F, double lnF, double T, double df)
+{
+    const double sqrtT = std::sqrt(T);
+    for (int it = 0; it < kIvIterations; ++it)
+    {
+        for (size_t j = 0; j < m; ++j)
+        {
+            const double s = vol[j];
+            const double sst = s * sqrtT;
+            const double d1 = (lnF - lnK[j] + 0.5 * s * s * T) / sst;
+            const double d2 = d1 - sst;
+            const double model = phi[j] * df * (F * normCdf(phi[j] * d1) - K[j] * normCdf(phi[j] * d2));
+            const double v = df * F * normPdf(d1) * sqrtT;
+            const double next = s - (model - target[j]) / std::max(v, 1e-12);
+            vol[j] = std::min(std::max(next, kMinVol), kMaxVol);
+        }
+    }
+}
+
+// Black-76 greeks at the given volatility. Rows solved in this pass (solved = 1) whose price
+// could not be matched get NaN; other rows keep their volatility and are not checked.
+static void computeGreeks(size_t m, const double *__restrict K, const double *__restrict lnK,
+                          const double *__restrict phi, const double *__restrict target,
+                          const double *__restrict solved, double *__restrict vol,
+                          double *__restrict delta, double *__restrict gamma, double *__restrict vega,
+                          double *__restrict theta, double F, double lnF, double T, double r, double df)
+{
+    const double sqrtT = std::sqrt(T);
+    const double tolerance = kPriceTolerance * F;
+    const double min_time_value = kMinTimeValue * F;
+    for (size_t j = 0; j < m; ++j)
+    {
+        const double s = vol[j];
+        const double sst = s * sqrtT;
+        const double d1 = (lnF - lnK[j] + 0.5 * s * s * T) / sst;
+        const double d2 = d1 - sst;
+        const double nd1 = normPdf(d1);
+        const double cdf1 = normCdf(phi[j] * d1);
+        const double model = phi[j] * df * (F * cdf1 - K[j] * normCdf(phi[j] * d2));
+        const double time_value = target[j] - df * std::max(phi[j] * (F - K[j]), 0.0);
+        const bool valid = ((std::abs(model - target[j]) <= tolerance) & (time_value > min_time_value)) |
+                           (solved[j] == 0.0);
+        const double mask = valid ? 1.0 : kNaN; // Multiplying by NaN invalidates every output at once
+
+        vol[j] = s * mask;
+        delta[j] = phi[j] * df * cdf1 * mask;
+        gamma[j] = df * nd1 / (F * sst) * mask;
+        vega[j] = df * F * nd1 * sqrtT * 0.01 * mask;
+        theta[j] = (r * model - df * F * nd1 * s / (2.0 * sqrtT)) / 365.0 * mask;
+    }
+}
+
+// Constructor for the OptionsChain class
+OptionsChain::OptionsChain(size_t threads) : pool_(threads == 0 ? 1 : threads)
+{
+}
+
+// Destructor: let queued work finish before the slices go away
+OptionsChain::~OptionsChain()
+{
+    pool_.join();
+}
+
+// Add one option, creating its expiry slice if needed
+void OptionsChain::addInstrument(const std::string &name, double strike, int64_t expiry_ms, bool call)
+{
+    if (index_.count(name) || strike <= 0.0)
+        return;
+
+    auto it = slice_by_expiry_.find(expiry_ms);
+    if (it == slice_by_expiry_.end())
+    {
+        it = slice_by_expiry_.emplace(expiry_ms, slices_.size()).first;
+        slices_.push_back(std::make_unique<ExpirySlice>());
+        slices_.back()->expiry_ms = expiry_ms;
+    }
+
+    ExpirySlice &slice = *slices_[it->second];
+    index_.emplace(name, std::make_pair(it->second, slice.name.size()));
+    slice.name.push_back(name);
+    slice.strike.push_back(strike);
+    slice.log_strike.push_back(std::log(strike));
+    slice.phi.push_back(call ? 1.0 : -1.0);
+    slice.mark.push_back(kNaN);
+    slice.iv_guess.push_back(kNaN);
+    slice.row_dirty.push_back(Clean);
+    slice.out.push_back({kNaN, kNaN, kNaN, kNaN, kNaN});
+}
+
+// Add every option from a public/get_instruments result
+size_t OptionsChain::loadInstruments(const json &instruments)
+{
+    size_t added = 0;
+    for (const json &instrument : instruments)
+    {
+        if (instrument.value("kind", "") != "option")
+            continue;
+
+        size_t before = index_.size();
+        addInstrument(instrument.value("instrument_name", ""),
+                      instrument.value("strike", 0.0),
+                      instrument.value("expiration_timestamp", int64_t{0}),
+                      instrument.value("option_type", "") == "call");
+        added += index_.size() - before;
+    }
+    return added;
+}
+
+// Record new inputs and mark the affected rows dirty
+bool OptionsChain::onTicker(const TickerUpdate &ticker)
+{
+    auto it = index_.find(ticker.instrument_name);
+    if (it == index_.end())
+        return false;
+
+    ExpirySlice &slice = *slices_[it->second.first];
+    const size_t row = it->second.second;
+    bool moved = false;
+
+    slice.valuation_ms = std::max<int64_t>(slice.valuation_ms, ticker.timestamp);
+    if (std::isfinite(ticker.interest_rate))
+        slice.rate = ticker.interest_rate;
+
+    // A new forward changes the greeks of every option of the expiry
+    if (std::isfinite(ticker.underlying_price) && ticker.underlying_price > 0.0 &&
+        ticker.underlying_price != slice.forward)
+    {
+        slice.forward = ticker.underlying_price;
+        for (uint8_t &state : slice.row_dirty)
+            state = std::max<uint8_t>(state, GreeksOnly);
+        slice.dirty = true;
+        moved = true;
+    }
+
+    // Only a new mark needs a new implied volatility
+    if (ticker.mark_price != slice.mark[row])
+    {
+        slice.mark[row] = ticker.mark_price;
+        slice.row_dirty[row] = Solve;
+        slice.dirty = true;
+    }
+
+    // Seed the solve with the exchange's mark IV until we have our own
+    if (!(slice.iv_guess[row] > 0.0) && ticker.mark_iv > 0.0)
+        slice.iv_guess[row] = ticker.mark_iv / 100.0;
+
+    return moved;
+}
+
+// Recompute every dirty expiry, in parallel when there is more than one
+size_t OptionsChain::recompute()
+{
+    std::vector<ExpirySlice *> dirty;
+    size_t rows = 0;
+    for (auto &slice : slices_)
+    {
+        if (!slice->dirty)
+            continue;
+        dirty.push_back(slice.get());
+        rows += slice->row_dirty.size() - std::count(slice->row_dirty.begin(), slice->row_dirty.end(), Clean);
+    }
+
+    if (dirty.size() == 1)
+    {
+        computeSlice(*dirty.front()); // Not worth a round trip through the pool
+    }
+    else if (!dirty.empty())
+    {
+        std::latch done(static_cast<std::ptrdiff_t>(dirty.size()));
+        for (ExpirySlice *slice : dirty)
+        {
+            boost::asio::post(pool_, [slice, &done]()
+                              {
+                computeSlice(*slice);
+                done.count_down(); });
+        }
+        done.wait();
+    }
+    return rows;
+}
+
+// Solve implied volatility and greeks for the dirty rows of one expiry
+void OptionsChain::computeSlice(ExpirySlice &slice)
+{
+    // Gather dirty rows into contiguous columns: rows to solve first, then greeks-only rows
+    slice.rows.clear();
+    for (uint32_t i = 0; i < slice.row_dirty.size(); ++i)
+    {
+        if (slice.row_dirty[i] == Solve)
+            slice.rows.push_back(i);
+    }
+    const size_t solve_rows = slice.rows.size();
+    for (uint32_t i = 0; i < slice.row_dirty.size(); ++i)
+    {
+        if (slice.row_dirty[i] == GreeksOnly)
+            slice.rows.push_back(i);
+    }
+    const size_t m = slice.rows.size();
+    slice.work.resize(m * WorkColumnCount);
+
+    double *col[WorkColumnCount];
+    for (int c = 0; c < WorkColumnCount; ++c)
+        col[c] = slice.work.data() + c * m;
+
+    // Per-expiry scalars
+    const double F = slice.forward;
+    const double lnF = std::log(F);
+    const double T = std::max(slice.expiry_ms - slice.valuation_ms, kMinTimeToExpiryMs) / kMsPerYear;
+    const double r = slice.rate;
+    const double df = fastExp(-r * T);
+
+    for (size_t j = 0; j < m; ++j)
+    {
+        const uint32_t i = slice.rows[j];
+        const bool solve = j < solve_rows;
+        col[KCol][j] = slice.strike[i];
+        col[LogKCol][j] = slice.log_strike[i];
+        col[PhiCol][j] = slice.phi[i];
+        col[PriceCol][j] = slice.mark[i] * F; // Deribit quotes option marks in the underlying
+        col[SolvedCol][j] = solve ? 1.0 : 0.0;
+        if (solve)
+            col[VolCol][j] = slice.iv_guess[i] > 0.0 ? slice.iv_guess[i] : 0.5;
+        else
+            col[VolCol][j] = slice.out[i].iv; // Sticky strike; NaN stays NaN
+    }
+
+    solveVolatility(solve_rows, col[KCol], col[LogKCol], col[PhiCol], col[PriceCol], col[VolCol], F, lnF, T, df);
+    computeGreeks(m, col[KCol], col[LogKCol], col[PhiCol], col[PriceCol], col[SolvedCol], col[VolCol],
+                  col[DeltaCol], col[GammaCol], col[VegaCol], col[ThetaCol], F, lnF, T, r, df);
+
+    // Scatter results back and keep solved volatilities as the next starting point
+    for (size_t j = 0; j < m; ++j)
+    {
+        const uint32_t i = slice.rows[j];
+        const double vol = col[VolCol][j];
+        slice.out[i] = {vol, col[DeltaCol][j], col[GammaCol][j], col[VegaCol][j], col[ThetaCol][j]};
+        if (vol > 0.0)
+            slice.iv_guess[i] = vol;
+        slice.row_dirty[i] = Clean;
+    }
+    slice.dirty = false;
+}
+
+// Latest analytics for one option
+const OptionGreeks *OptionsChain::greeks(const std::string &name) const
+{
+    auto it = index_.find(name);
+    if (it == index_.end())
+        return nullptr;
+    return &slices_[it->second.first]->out[it->second.second];
+}
+
+// Names of every option in the chain
+std::vector<std::string> OptionsChain::instruments() const
+{
+    std::vector<std::string> names;
+    names.reserve(index_.size());
+    for (const auto &slice : slices_)
+        names.insert(names.end(), slice->name.begin(), slice->name.end());
+    return names;
+}
+
+// Rows waiting for recompute()
+size_t OptionsChain::dirtyCount() const
+{
+    size_t rows = 0;
+    for (const auto &slice : slices_)
+        rows += slice->row_dirty.size() - std::count(slice->row_dirty.begin(), slice->row_dirty.end(), Clean);
+    return rows;
+}
+
+// Function to stream a full options chain and keep its greeks up to date
+void startOptionsChainSession(std::string &token)
+{
+    std::cout << "Enter the currency (e.g., BTC, ETH):\n";
+    std::string currency;
+    std::cin >> currency;
+
+    // List every live option of the currency over REST
+    DeribitClient restClient;
+    json response = restClient.getInstruments(currency, "option");
+    if (!response.contains("result"))
+    {
+        std::cerr << "Failed to load instruments: " << response.dump(4) << std::endl;
+        return;
+    }
+
+    OptionsChain chain;
+    chain.loadInstruments(response["result"]);
+    std::cout << "Loaded " << chain.size() << " options" << std::endl;
+
+    WebSocketClient wsClient;
+    wsClient.connect("test.deribit.com", "443");
+    wsClient.syncClock(8);
+
+    std::vector<std::string> channels;
+    for (const std::string &name : chain.instruments())
+        channels.push_back("ticker." + name + ".100ms");
+
+    // Recompute at once when a forward moves, otherwise at most once per millisecond.
+    // Updates inside the window are left to the deferred thread below, so a quiet chain
+    // still gets its last updates recomputed.
+    const auto kMinInterval = milliseconds(1);
+    std::mutex chain_mutex;             // Guards chain, last_recompute, deferred and stop
+    std::condition_variable wake;       // Signals the deferred thread
+    auto last_recompute = steady_clock::now();
+    bool deferred = false;              // Dirty rows are waiting for the window to pass
+    bool stop = false;                  // Set when the session ends
+
+    auto onTicker = [&](const TickerUpdate &ticker)
+    {
+        std::lock_guard<std::mutex> lock(chain_mutex);
+        bool moved = chain.onTicker(ticker);
+        auto now = steady_clock::now();
+        if (!moved && now - last_recompute < kMinInterval)
+        {
+            if (!deferred)
+            {
+                deferred = true;
+                wake.notify_one();
+            }
+            return;
+        }
+
+        size_t rows = chain.recompute();
+        auto elapsed = duration_cast<microseconds>(steady_clock::now() - now).count();
+        last_recompute = steady_clock::now();
+        deferred = false;
+
+        if (const OptionGreeks *g = chain.greeks(ticker.instrument_name))
+        {
+            std::cout << ticker.instrument_name << " iv " << g->iv << " delta " << g->delta
+                      << " gamma " << g->gamma << " vega " << g->vega << " theta " << g->theta
+                      << " (" << rows << " rows in " << elapsed << " us)\n";
+        }
+    };
+    wsClient.subscribe<TickerUpdate>(channels, token, onTicker);
+
+    // Recompute deferred updates once the window since the last recompute has passed
+    std::thread deferredRecompute([&]()
+                                  {
+        std::unique_lock<std::mutex> lock(chain_mutex);
+        while (true)
+        {
+            wake.wait(lock, [&] { return deferred || stop; });
+            if (stop)
+                return;
+            if (wake.wait_until(lock, last_recompute + kMinInterval, [&] { return stop; }))
+                return;
+            if (!deferred)
+                continue; // A ticker recomputed in the meantime
+
+            auto start = steady_clock::now();
+            size_t rows = chain.recompute();
+            last_recompute = steady_clock::now();
+            deferred = false;
+            std::cout << "Deferred recompute: " << rows << " rows in "
+                      << duration_cast<microseconds>(last_recompute - start).count() << " us\n";
+        } });
+
+    // Start a separate thread to continuously listen for WebSocket updates
+    std::thread listener([&wsClient]()
+                         { wsClient.listen(); });
+
+    listener.join(); // Wait for the listener thread to finish execution
+
+    {
+        std::lock_guard<std::mutex> lock(chain_mutex);
+        stop = true;
+    }
+    wake.notify_one();
+    deferredRecompute.join();
+}
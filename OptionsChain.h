@@ -0,0 +1,145 @@
+#ifndef OPTIONSCHAIN_H
+#define OPTIONSCHAIN_H
+
+// Standard C++ headers
+#include <cstdint>       // Fixed-width integer types
+#include <memory>        // Owning pointers to expiry slices
+#include <string>        // String handling
+#include <unordered_map> // Instrument-to-row index
+#include <vector>        // Column storage
+
+// Boost headers for the worker pool
+#include <boost/asio/thread_pool.hpp>   // Fixed-size thread pool
+#include <nlohmann/json.hpp>            // JSON parsing and handling
+
+#include "ChannelDispatcher.h"          // TickerUpdate messages
+
+/**
+ * @brief Implied volatility and Black-76 greeks of one option, in quote currency (USD).
+ */
+struct OptionGreeks {
+    double iv;     ///< Implied volatility (1.0 = 100%), NaN if the price has no solution
+    double delta;  ///< dV/dF
+    double gamma;  ///< d2V/dF2
+    double vega;   ///< dV per 1 volatility point (0.01)
+    double theta;  ///< dV per calendar day
+};
+
+/**
+ * @class OptionsChain
+ * @brief Options chain analytics fed from `ticker.*` notifications.
+ *
+ * Options are grouped by expiry and each expiry is stored as structure-of-arrays.
+ * Ticker updates only mark rows dirty; recompute() solves implied volatility and
+ * greeks for the dirty rows of each changed expiry, spreading expiries over a thread
+ * pool. Only rows with a new mark re-solve implied volatility. A move in an expiry's
+ * forward refreshes the greeks of every other row at its last solved volatility
+ * (sticky strike), since re-solving an unchanged mark against a new forward would
+ * shift its volatility artificially.
+ *
+ * Not thread-safe: call onTicker(), recompute() and the accessors from one thread.
+ */
+class OptionsChain {
+public:
+    /**
+     * @brief Constructs an empty chain.
+     * @param threads Number of worker threads used by recompute().
+     */
+    explicit OptionsChain(size_t threads = 2);
+
+    /**
+     * @brief Waits for the worker threads to finish.
+     */
+    ~OptionsChain();
+
+    OptionsChain(const OptionsChain&) = delete;
+    OptionsChain& operator=(const OptionsChain&) = delete;
+
+    /**
+     * @brief Adds an option to the chain.
+     * @param name Instrument name (e.g. `BTC-27DEC24-60000-C`).
+     * @param strike Strike price.
+     * @param expiry_ms Expiration timestamp (ms).
+     * @param call True for calls, false for puts.
+     */
+    void addInstrument(const std::string& name, double strike, int64_t expiry_ms, bool call);
+
+    /**
+     * @brief Adds every option of a `public/get_instruments` result.
+     * @param instruments The `result` array of the response.
+     * @return The number of options added.
+     */
+    size_t loadInstruments(const nlohmann::json& instruments);
+
+    /**
+     * @brief Applies a ticker update to the chain.
+     * @return True if the update moved the forward of its expiry.
+     */
+    bool onTicker(const TickerUpdate& ticker);
+
+    /**
+     * @brief Recomputes implied volatility and greeks for every dirty row.
+     * @return The number of rows recomputed.
+     */
+    size_t recompute();
+
+    /**
+     * @brief Returns the latest analytics for an option.
+     * @return nullptr if the instrument is not in the chain.
+     */
+    const OptionGreeks* greeks(const std::string& name) const;
+
+    /// Names of all options in the chain.
+    std::vector<std::string> instruments() const;
+
+    /// Number of options in the chain.
+    size_t size() const { return index_.size(); }
+
+    /// Number of rows awaiting recompute().
+    size_t dirtyCount() const;
+
+private:
+    /// What recompute() must do for a row.
+    enum RowState : uint8_t {
+        Clean = 0,       ///< Results are current
+        GreeksOnly = 1,  ///< Forward moved: recompute greeks at the last solved volatility
+        Solve = 2,       ///< New mark: solve implied volatility, then greeks
+    };
+
+    /// All options of one expiry, stored column-wise.
+    struct ExpirySlice {
+        int64_t expiry_ms = 0;          ///< Expiration timestamp (ms)
+        int64_t valuation_ms = 0;       ///< Latest ticker timestamp seen for this expiry
+        double forward = 0.0;           ///< Underlying (forward) price
+        double rate = 0.0;              ///< Interest rate
+        bool dirty = false;             ///< True if any row is dirty
+
+        std::vector<std::string> name;  ///< Instrument names
+        std::vector<double> strike;     ///< Strikes
+        std::vector<double> log_strike; ///< ln(strike), precomputed
+        std::vector<double> phi;        ///< +1 for calls, -1 for puts
+        std::vector<double> mark;       ///< Mark price in units of the underlying
+        std::vector<double> iv_guess;   ///< Starting point for the IV solve
+        std::vector<uint8_t> row_dirty; ///< RowState of each row
+        std::vector<OptionGreeks> out;  ///< Latest results
+
+        std::vector<uint32_t> rows;     ///< Scratch: indices of dirty rows
+        std::vector<double> work;       ///< Scratch: gathered kernel inputs and outputs
+    };
+
+    static void computeSlice(ExpirySlice& slice); ///< Runs the kernel on a slice's dirty rows
+
+    boost::asio::thread_pool pool_;                         ///< Workers for recompute()
+    std::vector<std::unique_ptr<ExpirySlice>> slices_;      ///< One slice per expiry
+    std::unordered_map<int64_t, size_t> slice_by_expiry_;   ///< Expiry to slice index
+    std::unordered_map<std::string, std::pair<size_t, size_t>> index_; ///< Name to (slice, row)
+};
+
+/**
+ * @brief Starts an options chain session: subscribes to the tickers of every live option
+ *        of a currency and prints refreshed greeks.
+ * @param token Authentication token required for WebSocket subscriptions.
+ */
+void startOptionsChainSession(std::string& token);
+
+#endif // OPTIONSCHAIN_H
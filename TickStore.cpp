@@ -0,0 +1,403 @@
+#include "TickStore.h"   // Include the TickStore header file
+#include <algorithm>     // For std::min and std::max
+#include <chrono>        // For converting days to calendar dates
+#include <cmath>         // For std::llround
+#include <cstdio>        // For std::snprintf
+#include <cstring>       // For std::memcpy
+#include <filesystem>    // For creating directories and file sizes
+#include <fstream>       // For appending blocks to files
+#include <iostream>      // For error reporting
+
+namespace bip = boost::interprocess;
+
+// Block header magic ("TKS1")
+static constexpr uint32_t kBlockMagic = 0x31534B54;
+
+// Prices and amounts are stored as fixed-point integers with 8 decimal places
+static constexpr double kFixedScale = 1e8;
+
+// Milliseconds per UTC day
+static constexpr int64_t kMsPerDay = 86'400'000;
+
+// Column order inside a block
+enum Column { TimestampColumn = 0, PriceColumn, AmountColumn, SideColumn, ChangeIdColumn, ColumnCount };
+
+// Map signed integers to unsigned so small negative deltas stay small
+static inline uint64_t zigzagEncode(int64_t v)
+{
+    return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+static inline int64_t zigzagDecode(uint64_t v)
+{
+    return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+
+// Append a LEB128 varint to a buffer
+static inline void putVarint(std::string &buf, uint64_t v)
+{
+    while (v >= 0x80)
+    {
+        buf.push_back(static_cast<char>(v | 0x80));
+        v >>= 7;
+    }
+    buf.push_back(static_cast<char>(v));
+}
+
+// Read a LEB128 varint and advance the cursor, never reading at or past end
+static inline uint64_t getVarint(const uint8_t *&p, const uint8_t *end)
+{
+    if (p == end)
+        return 0; // Truncated column
+    uint64_t b = *p++;
+    if (b < 0x80)
+        return b; // Fast path: most deltas fit in one byte
+
+    uint64_t v = b & 0x7F;
+    int shift = 7;
+    while (p != end && shift < 64)
+    {
+        b = *p++;
+        v |= (b & 0x7F) << shift;
+        shift += 7;
+        if (!(b & 0x80))
+            break;
+    }
+    return v;
+}
+
+// Encode a column of integers as zigzag varints of successive differences
+static void encodeDeltas(const std::vector<int64_t> &values, std::string &out)
+{
+    int64_t prev = 0;
+    for (int64_t v : values)
+    {
+        putVarint(out, zigzagEncode(v - prev));
+        prev = v;
+    }
+}
+
+// Decode a delta column occupying [p, end) into dst[0..rows)
+static void decodeDeltas(const uint8_t *p, const uint8_t *end, size_t rows, int64_t *dst)
+{
+    uint64_t prev = 0; // Unsigned so corrupt deltas wrap instead of overflowing
+    for (size_t i = 0; i < rows; ++i)
+    {
+        prev += static_cast<uint64_t>(zigzagDecode(getVarint(p, end)));
+        dst[i] = static_cast<int64_t>(prev);
+    }
+}
+
+void TickColumns::clear()
+{
+    timestamp.clear();
+    price.clear();
+    amount.clear();
+    side.clear();
+    change_id.clear();
+}
+
+// Constructor for the TickStore class
+TickStore::TickStore(std::string root, size_t rows_per_block, std::chrono::milliseconds flush_interval)
+    : root_(std::move(root)), rows_per_block_(rows_per_block == 0 ? 1 : rows_per_block),
+      flush_interval_(std::max(flush_interval, std::chrono::milliseconds(1)))
+{
+    writer_ = std::thread([this] { writerLoop(); });
+}
+
+// Destructor: make sure nothing buffered is lost, then stop the writer
+TickStore::~TickStore()
+{
+    flush();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    writer_.join();
+}
+
+// Build <root>/<instrument>/<YYYYMMDD>.tks
+std::string TickStore::filePath(const std::string &root, const std::string &instrument, int64_t day)
+{
+    std::chrono::year_month_day ymd{std::chrono::sys_days{std::chrono::days{day}}};
+    char name[16];
+    std::snprintf(name, sizeof(name), "%04d%02u%02u.tks",
+                  static_cast<int>(ymd.year()), static_cast<unsigned>(ymd.month()), static_cast<unsigned>(ymd.day()));
+    return (std::filesystem::path(root) / instrument / name).string();
+}
+
+// Append a single row, sealing a block when the partition is full or the day rolls over
+void TickStore::append(const std::string &instrument, const Tick &tick)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Partition &partition = partitions_[instrument];
+
+    int64_t day = tick.timestamp / kMsPerDay;
+    if (day != partition.day)
+    {
+        seal(instrument, partition); // Rows of the previous day go to the previous file
+        partition.day = day;
+    }
+
+    if (partition.rows.empty())
+    {
+        partition.opened = Clock::now(); // Starts the flush_interval countdown
+        partition.rows.reserve(rows_per_block_);
+    }
+    partition.rows.push_back(tick);
+
+    if (partition.rows.size() >= rows_per_block_)
+        seal(instrument, partition);
+}
+
+// Store every level change of a book update
+void TickStore::appendBook(const BookUpdate &update)
+{
+    for (const PriceLevel &level : update.bids)
+        append(update.instrument_name, {update.timestamp, level.price, level.amount, TickSide::Bid, update.change_id});
+    for (const PriceLevel &level : update.asks)
+        append(update.instrument_name, {update.timestamp, level.price, level.amount, TickSide::Ask, update.change_id});
+}
+
+// Store every trade of a trades notification
+void TickStore::appendTrades(const TradesUpdate &update)
+{
+    for (const Trade &trade : update.trades)
+        append(trade.instrument_name, {trade.timestamp, trade.price, trade.amount,
+                                       trade.buy ? TickSide::Buy : TickSide::Sell, trade.trade_seq});
+}
+
+// Seal every partition and wait until the writer has written them
+void TickStore::flush()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (auto &[instrument, partition] : partitions_)
+        seal(instrument, partition);
+
+    const uint64_t target = blocks_sealed_;
+    written_.wait(lock, [&] { return blocks_written_ >= target; });
+}
+
+// Hand the buffered rows of a partition to the writer thread
+void TickStore::seal(const std::string &instrument, Partition &partition)
+{
+    if (partition.rows.empty())
+        return;
+
+    sealed_.push_back({instrument, partition.day, std::move(partition.rows)});
+    partition.rows = std::vector<Tick>();
+    ++blocks_sealed_;
+    wake_.notify_one();
+}
+
+// Seal partitions that have waited flush_interval and write sealed blocks in order
+void TickStore::writerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true)
+    {
+        wake_.wait_for(lock, std::max(flush_interval_ / 4, std::chrono::milliseconds(1)),
+                       [this] { return stopping_ || !sealed_.empty(); });
+
+        const Clock::time_point now = Clock::now();
+        for (auto &[instrument, partition] : partitions_)
+        {
+            if (!partition.rows.empty() && now - partition.opened >= flush_interval_)
+                seal(instrument, partition);
+        }
+
+        if (sealed_.empty())
+        {
+            if (stopping_)
+                return;
+            continue;
+        }
+
+        // Encode and write without holding the lock so append() is never blocked on the disk
+        std::vector<SealedBlock> batch;
+        batch.swap(sealed_);
+        lock.unlock();
+        for (const SealedBlock &block : batch)
+            writeBlock(block);
+        lock.lock();
+
+        blocks_written_ += batch.size();
+        written_.notify_all();
+    }
+}
+
+// Encode a sealed block and append it to its file in one write
+void TickStore::writeBlock(const SealedBlock &sealed) const
+{
+    const std::vector<Tick> &rows = sealed.rows;
+
+    const size_t n = rows.size();
+    std::vector<int64_t> timestamps(n), prices(n), change_ids(n);
+    std::string columns[ColumnCount];
+
+    TickBlockHeader header{};
+    header.magic = kBlockMagic;
+    header.rows = static_cast<uint32_t>(n);
+    header.min_timestamp = rows[0].timestamp;
+    header.max_timestamp = rows[0].timestamp;
+
+    columns[SideColumn].resize(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        timestamps[i] = rows[i].timestamp;
+        prices[i] = std::llround(rows[i].price * kFixedScale);
+        change_ids[i] = rows[i].change_id;
+        columns[SideColumn][i] = static_cast<char>(rows[i].side);
+        header.min_timestamp = std::min(header.min_timestamp, rows[i].timestamp);
+        header.max_timestamp = std::max(header.max_timestamp, rows[i].timestamp);
+    }
+
+    encodeDeltas(timestamps, columns[TimestampColumn]);
+    encodeDeltas(prices, columns[PriceColumn]);
+    encodeDeltas(change_ids, columns[ChangeIdColumn]);
+    for (const Tick &tick : rows)
+        putVarint(columns[AmountColumn], zigzagEncode(std::llround(tick.amount * kFixedScale)));
+
+    // Assemble header and columns into a single buffer so the file sees one sequential write
+    size_t total = sizeof(header);
+    for (int c = 0; c < ColumnCount; ++c)
+    {
+        header.column_bytes[c] = static_cast<uint32_t>(columns[c].size());
+        total += columns[c].size();
+    }
+    std::string block;
+    block.reserve(total);
+    block.append(reinterpret_cast<const char *>(&header), sizeof(header));
+    for (int c = 0; c < ColumnCount; ++c)
+        block.append(columns[c]);
+
+    std::string path = filePath(root_, sealed.instrument, sealed.day);
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+
+    std::ofstream file(path, std::ios::binary | std::ios::app);
+    if (!file.write(block.data(), static_cast<std::streamsize>(block.size())))
+        std::cerr << "Failed to write tick block to " << path << std::endl;
+}
+
+// Map the file and index its complete blocks
+TickReader::TickReader(const std::string &path)
+{
+    std::error_code ec;
+    std::uintmax_t size = std::filesystem::file_size(path, ec);
+    if (ec)
+        throw bip::interprocess_exception(("Cannot open tick file " + path + ": " + ec.message()).c_str());
+    if (size == 0)
+        return; // Nothing to map
+
+    file_ = bip::file_mapping(path.c_str(), bip::read_only);
+    region_ = bip::mapped_region(file_, bip::read_only);
+
+    const uint8_t *p = static_cast<const uint8_t *>(region_.get_address());
+    const uint8_t *end = p + region_.get_size();
+    while (static_cast<size_t>(end - p) >= sizeof(TickBlockHeader))
+    {
+        TickBlockHeader header;
+        std::memcpy(&header, p, sizeof(header)); // Blocks are not aligned inside the file
+        if (header.magic != kBlockMagic)
+            break; // Corrupt data; stop at the last good block
+
+        size_t body = 0;
+        for (uint32_t bytes : header.column_bytes)
+            body += bytes;
+        if (static_cast<size_t>(end - p) < sizeof(TickBlockHeader) + body)
+            break; // Partially written trailing block
+        if (header.column_bytes[SideColumn] != header.rows)
+            break; // Corrupt data: the side column stores one byte per row
+
+        blocks_.push_back({header, p + sizeof(TickBlockHeader)});
+        rows_ += header.rows;
+        p += sizeof(TickBlockHeader) + body;
+    }
+}
+
+// Decode all columns of a block, appending to out
+void TickReader::decodeBlock(const Block &block, TickColumns &out, std::vector<int64_t> &scratch) const
+{
+    const TickBlockHeader &header = block.header;
+    const size_t n = header.rows;
+    const size_t base = out.size();
+
+    const uint8_t *col[ColumnCount + 1]; // Column c occupies [col[c], col[c + 1])
+    col[0] = block.columns;
+    for (int c = 0; c < ColumnCount; ++c)
+        col[c + 1] = col[c] + header.column_bytes[c];
+
+    out.timestamp.resize(base + n);
+    out.price.resize(base + n);
+    out.amount.resize(base + n);
+    out.side.resize(base + n);
+    out.change_id.resize(base + n);
+
+    decodeDeltas(col[TimestampColumn], col[TimestampColumn + 1], n, out.timestamp.data() + base);
+    decodeDeltas(col[ChangeIdColumn], col[ChangeIdColumn + 1], n, out.change_id.data() + base);
+    std::memcpy(out.side.data() + base, col[SideColumn], n);
+
+    // Decode fixed-point integers into scratch space, then convert in a separate, vectorizable pass
+    scratch.resize(2 * n);
+    int64_t *price_fixed = scratch.data();
+    int64_t *amount_fixed = scratch.data() + n;
+    decodeDeltas(col[PriceColumn], col[PriceColumn + 1], n, price_fixed);
+    const uint8_t *p = col[AmountColumn];
+    const uint8_t *amount_end = col[AmountColumn + 1];
+    for (size_t i = 0; i < n; ++i)
+        amount_fixed[i] = zigzagDecode(getVarint(p, amount_end));
+
+    double *price = out.price.data() + base;
+    double *amount = out.amount.data() + base;
+    for (size_t i = 0; i < n; ++i)
+    {
+        price[i] = static_cast<double>(price_fixed[i]) / kFixedScale;
+        amount[i] = static_cast<double>(amount_fixed[i]) / kFixedScale;
+    }
+}
+
+// Append rows with from <= timestamp < to
+size_t TickReader::scan(int64_t from, int64_t to, TickColumns &out) const
+{
+    const size_t start = out.size();
+    std::vector<int64_t> scratch; // Fixed-point staging reused across blocks
+    for (const Block &block : blocks_)
+    {
+        const TickBlockHeader &header = block.header;
+        if (header.max_timestamp < from || header.min_timestamp >= to)
+            continue; // Block lies entirely outside the range
+
+        const size_t base = out.size();
+        decodeBlock(block, out, scratch);
+        if (header.min_timestamp >= from && header.max_timestamp < to)
+            continue; // Block lies entirely inside the range
+
+        // Branch-free compaction of the rows that fall inside the range
+        const size_t n = header.rows;
+        int64_t *ts = out.timestamp.data() + base;
+        double *price = out.price.data() + base;
+        double *amount = out.amount.data() + base;
+        uint8_t *side = out.side.data() + base;
+        int64_t *change_id = out.change_id.data() + base;
+        size_t kept = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const int64_t t = ts[i];
+            ts[kept] = t;
+            price[kept] = price[i];
+            amount[kept] = amount[i];
+            side[kept] = side[i];
+            change_id[kept] = change_id[i];
+            kept += static_cast<size_t>((t >= from) & (t < to));
+        }
+
+        out.timestamp.resize(base + kept);
+        out.price.resize(base + kept);
+        out.amount.resize(base + kept);
+        out.side.resize(base + kept);
+        out.change_id.resize(base + kept);
+    }
+    return out.size() - start;
+}
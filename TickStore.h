@@ -0,0 +1,206 @@
+#ifndef TICKSTORE_H
+#define TICKSTORE_H
+
+// Standard C++ headers
+#include <chrono>        // Flush interval
+#include <condition_variable> // Writer thread wakeups
+#include <cstdint>       // Fixed-width integer types
+#include <mutex>         // Mutex for thread synchronization
+#include <string>        // String handling
+#include <thread>        // Background writer thread
+#include <unordered_map> // Per-instrument partitions
+#include <vector>        // Column buffers
+
+// Boost headers for memory-mapped file access
+#include <boost/interprocess/file_mapping.hpp>  // File mapping object
+#include <boost/interprocess/mapped_region.hpp> // Mapped view of a file
+
+#include "ChannelDispatcher.h" // BookUpdate and TradesUpdate messages
+
+/**
+ * @brief Side of a stored tick.
+ * Book level deletions are stored with an amount of 0.
+ */
+enum class TickSide : uint8_t { Bid = 0, Ask = 1, Buy = 2, Sell = 3 };
+
+/**
+ * @brief One row of the tick store.
+ */
+struct Tick {
+    int64_t timestamp;   ///< Server timestamp (ms)
+    double price;        ///< Price (stored with 8 decimal places)
+    double amount;       ///< Amount (stored with 8 decimal places)
+    TickSide side;       ///< Book side or trade aggressor side
+    int64_t change_id;   ///< Book change_id, or trade_seq for trades
+};
+
+/**
+ * @brief Decoded ticks in structure-of-arrays form, as returned by TickReader.
+ */
+struct TickColumns {
+    std::vector<int64_t> timestamp;  ///< Server timestamps (ms)
+    std::vector<double> price;       ///< Prices
+    std::vector<double> amount;      ///< Amounts
+    std::vector<uint8_t> side;       ///< TickSide values
+    std::vector<int64_t> change_id;  ///< Change ids / trade sequence numbers
+
+    size_t size() const { return timestamp.size(); }
+    void clear();
+};
+
+/**
+ * @brief Fixed-size header written in front of each block of a tick file.
+ * The five columns follow the header in order, each delta/zigzag/varint encoded
+ * except the side column, which is stored as raw bytes.
+ */
+struct TickBlockHeader {
+    uint32_t magic;          ///< kBlockMagic
+    uint32_t rows;           ///< Number of rows in the block
+    int64_t min_timestamp;   ///< Smallest timestamp in the block
+    int64_t max_timestamp;   ///< Largest timestamp in the block
+    uint32_t column_bytes[5];///< Encoded size of each column
+    uint32_t reserved;       ///< Padding, always 0
+};
+
+/**
+ * @class TickStore
+ * @brief Appends book updates and trades to per-instrument, per-day columnar files.
+ *
+ * Rows are buffered per instrument and sealed into a block once `rows_per_block` rows
+ * have accumulated, the oldest buffered row is `flush_interval` old, the UTC day
+ * changes, or flush() is called. Sealed blocks are encoded and written by a background
+ * thread, so append() never waits on the disk.
+ * Files live at `<root>/<instrument>/<YYYYMMDD>.tks`.
+ */
+class TickStore {
+public:
+    /// Default number of rows buffered per instrument before a block is written.
+    static constexpr size_t kDefaultRowsPerBlock = 65536;
+
+    /// Default age of the oldest buffered row at which a partition is written anyway.
+    static constexpr std::chrono::milliseconds kDefaultFlushInterval{2000};
+
+    /**
+     * @brief Constructs a TickStore rooted at a directory and starts its writer thread.
+     * @param root Directory that receives one subdirectory per instrument.
+     * @param rows_per_block Maximum number of rows per written block.
+     * @param flush_interval Longest time a row stays buffered in memory.
+     */
+    explicit TickStore(std::string root, size_t rows_per_block = kDefaultRowsPerBlock,
+                       std::chrono::milliseconds flush_interval = kDefaultFlushInterval);
+
+    /**
+     * @brief Flushes all buffered rows and stops the writer thread.
+     */
+    ~TickStore();
+
+    TickStore(const TickStore&) = delete;
+    TickStore& operator=(const TickStore&) = delete;
+
+    /**
+     * @brief Appends a single row.
+     * @param instrument Instrument the row belongs to.
+     * @param tick The row to store.
+     */
+    void append(const std::string& instrument, const Tick& tick);
+
+    /**
+     * @brief Appends every level change of a book update.
+     */
+    void appendBook(const BookUpdate& update);
+
+    /**
+     * @brief Appends every trade of a trades notification.
+     */
+    void appendTrades(const TradesUpdate& update);
+
+    /**
+     * @brief Writes all buffered rows to disk and waits until they are written.
+     */
+    void flush();
+
+    /**
+     * @brief Builds the file path for an instrument and UTC day.
+     * @param root Store root directory.
+     * @param instrument Instrument name.
+     * @param day Days since the Unix epoch (UTC).
+     */
+    static std::string filePath(const std::string& root, const std::string& instrument, int64_t day);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Partition {
+        int64_t day = -1;            ///< UTC day of the buffered rows
+        Clock::time_point opened;    ///< When the oldest buffered row was appended
+        std::vector<Tick> rows;      ///< Rows not yet sealed
+    };
+
+    struct SealedBlock {
+        std::string instrument;      ///< Instrument the rows belong to
+        int64_t day;                 ///< UTC day of the rows
+        std::vector<Tick> rows;      ///< Rows to encode and write
+    };
+
+    void seal(const std::string& instrument, Partition& partition); ///< Mutex must be held
+    void writerLoop();                                               ///< Body of the writer thread
+    void writeBlock(const SealedBlock& block) const;                 ///< Runs on the writer thread
+
+    std::string root_;                                     ///< Store root directory
+    size_t rows_per_block_;                                ///< Rows per block
+    std::chrono::milliseconds flush_interval_;             ///< Longest time a row stays buffered
+    std::mutex mutex_;                                     ///< Guards everything below
+    std::condition_variable wake_;                         ///< Signals the writer thread
+    std::condition_variable written_;                      ///< Signals flush() waiters
+    std::unordered_map<std::string, Partition> partitions_; ///< Buffered rows per instrument
+    std::vector<SealedBlock> sealed_;                      ///< Blocks waiting for the writer
+    uint64_t blocks_sealed_ = 0;                           ///< Blocks handed to the writer so far
+    uint64_t blocks_written_ = 0;                          ///< Blocks the writer has finished
+    bool stopping_ = false;                                ///< Set by the destructor
+    std::thread writer_;                                   ///< Encodes and writes sealed blocks
+};
+
+/**
+ * @class TickReader
+ * @brief Memory-maps a tick file and scans time ranges.
+ *
+ * Blocks whose timestamp range lies outside the query are skipped from the header
+ * alone; blocks fully inside the range are appended without filtering.
+ */
+class TickReader {
+public:
+    /**
+     * @brief Maps a tick file and indexes its blocks.
+     * @param path Path to a `.tks` file.
+     * @throws boost::interprocess::interprocess_exception if the file does not exist or
+     *         cannot be mapped.
+     */
+    explicit TickReader(const std::string& path);
+
+    /// Total number of rows in the file.
+    size_t rowCount() const { return rows_; }
+
+    /// Number of complete blocks in the file.
+    size_t blockCount() const { return blocks_.size(); }
+
+    /**
+     * @brief Appends all rows with `from <= timestamp < to` to `out`.
+     * @return The number of rows appended.
+     */
+    size_t scan(int64_t from, int64_t to, TickColumns& out) const;
+
+private:
+    struct Block {
+        TickBlockHeader header;         ///< Copy of the block header
+        const uint8_t* columns;         ///< Start of the encoded columns
+    };
+
+    void decodeBlock(const Block& block, TickColumns& out, std::vector<int64_t>& scratch) const;
+
+    boost::interprocess::file_mapping file_;   ///< Mapped file
+    boost::interprocess::mapped_region region_; ///< Read-only view of the whole file
+    std::vector<Block> blocks_;                ///< Index of complete blocks
+    size_t rows_ = 0;                          ///< Total rows across blocks
+};
+
+#endif // TICKSTORE_H
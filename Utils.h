@@ -16,6 +16,7 @@ void displayMenu() {
     cout << "7. Sell Order\n";        // Option to place a sell order
     cout << "8. Realtime Data\n";     // Option to access real-time market data
     cout << "9. Exit\n";              // Option to exit the program
+    cout << "10. Options Chain Greeks\n"; // Option to stream greeks for a full options chain
     cout << "-------------------------------\n"; // Separator for clarity
     cout << "Enter your choice: ";    // Prompt user for input
 }
@@ -1,9 +1,13 @@
 #include "WebSocketClient.h" // Include the WebSocketClient header file
+#include "APIClient.h"       // REST client used for clock sampling
+#include "TickStore.h"       // On-disk storage of received ticks
 #include <iostream>          // Standard I/O stream
 #include <string>            // String handling
 #include <thread>            // Threading support
 #include <mutex>             // Mutex for thread safety
 #include <chrono>            // Time-related functions
+#include <algorithm>         // For std::max and std::clamp
+#include <limits>            // For discarding invalid input
 #include <boost/asio.hpp>    // Boost.Asio for network communication
 #include <boost/asio/ssl.hpp> // Boost.Asio for SSL connections
 #include <boost/asio/ip/tcp.hpp> // TCP support
@@ -63,7 +67,7 @@ void WebSocketClient::connect(const std::string &host, const std::string &port)
     auto ep = net::connect(beast::get_lowest_layer(ws), results);
 
     // Configure SSL settings
-    if (!SSL_set_tlsext_host_name(ws.next_layer().native_handle(), host.c_str()))
+    if (!SSL_set_tlsext_host_name(ws.next_layer().next_layer().native_handle(), host.c_str()))
     {
         beast::error_code ec{
             static_cast<int>(::ERR_get_error()),
@@ -72,11 +76,34 @@ void WebSocketClient::connect(const std::string &host, const std::string &port)
     }
 
     // Perform SSL handshake
-    ws.next_layer().handshake(ssl::stream_base::client);
+    ws.next_layer().next_layer().handshake(ssl::stream_base::client);
 
-    // Perform WebSocket handshake
-    ws.handshake(host + ":" + port, "/ws/api/v2");
+    // Offer the configured compression settings
+    ws.set_option(compression_);
+
+    // Perform WebSocket handshake, keeping the response to see which extensions were accepted
+    websocket::response_type res;
+    ws.handshake(res, host + ":" + port, "/ws/api/v2");
     std::cout << "WebSocket connected to " << host << " : " << port << std::endl;
+
+    if (compression_.client_enable)
+    {
+        auto extensions = res.find(beast::http::field::sec_websocket_extensions);
+        if (extensions != res.end())
+            std::cout << "Negotiated extensions: " << extensions->value() << std::endl;
+        else
+            std::cout << "Server declined permessage-deflate" << std::endl;
+    }
+}
+
+// Function to set the compression options used by the next handshake
+void WebSocketClient::setCompression(const websocket::permessage_deflate &options)
+{
+    // Beast's set_option throws on values outside these ranges, so keep connect() safe
+    compression_ = options;
+    compression_.server_max_window_bits = std::clamp(compression_.server_max_window_bits, 9, 15);
+    compression_.client_max_window_bits = std::clamp(compression_.client_max_window_bits, 9, 15);
+    compression_.memLevel = std::clamp(compression_.memLevel, 1, 9);
 }
 
 // Function to subscribe to a specific WebSocket channel
@@ -85,7 +112,7 @@ void WebSocketClient::subscribe(const std::string &channel, const std::string &t
     // Create a JSON request payload for subscription
     json payload = {
         {"jsonrpc", "2.0"},
-        {"id", 1},
+        {"id", next_id_++},
         {"method", "private/subscribe"},
         {"params", {{"access_token", token}, {"channels", {channel}}}}};
 
@@ -94,6 +121,105 @@ void WebSocketClient::subscribe(const std::string &channel, const std::string &t
     std::cout << "Subscribed to channel: " << channel << std::endl;
 }
 
+// Function to subscribe to several WebSocket channels in one request
+void WebSocketClient::subscribe(const std::vector<std::string> &channels, const std::string &token)
+{
+    // Create a JSON request payload for subscription
+    json payload = {
+        {"jsonrpc", "2.0"},
+        {"id", next_id_++},
+        {"method", "private/subscribe"},
+        {"params", {{"access_token", token}, {"channels", channels}}}};
+
+    // Send the subscription request via WebSocket
+    ws.write(net::buffer(payload.dump()));
+    std::cout << "Subscribed to " << channels.size() << " channels" << std::endl;
+}
+
+// Function to send a public/get_time request and remember when it left
+int WebSocketClient::sendTimeRequest()
+{
+    int id = next_id_++;
+    json payload = {
+        {"jsonrpc", "2.0"},
+        {"id", id},
+        {"method", "public/get_time"},
+        {"params", json::object()}};
+
+    std::string message = payload.dump(); // Serialize before taking the send timestamp
+    pending_time_send_ns_ = clock_.localNowNs();
+    ws.write(net::buffer(message));
+    return id;
+}
+
+// Function to sample the server clock with a series of get_time round trips
+int WebSocketClient::syncClock(int count)
+{
+    int recorded = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        int id = sendTimeRequest();
+
+        // Read until the matching response arrives; nothing else is subscribed yet
+        while (true)
+        {
+            beast::flat_buffer buffer;
+            ws.read(buffer);
+            int64_t recv_ns = clock_.localNowNs();
+
+            json response = json::parse(beast::buffers_to_string(buffer.data()));
+            if (response.value("id", 0) != id)
+                continue;
+
+            if (response.contains("result") && response["result"].is_number_integer())
+            {
+                clock_.addSample(pending_time_send_ns_, response["result"].get<int64_t>(), recv_ns);
+                ++recorded;
+            }
+            break;
+        }
+    }
+
+    std::cout << "Clock synced: offset " << clock_.offsetNs(clock_.localNowNs()) / 1e6
+              << " ms, min RTT " << clock_.minRttNs() / 1e6 << " ms" << std::endl;
+    return recorded;
+}
+
+// Function to access the clock offset estimator
+ClockSync &WebSocketClient::clockSync()
+{
+    return clock_;
+}
+
+// Function to collect the traffic counters of every active channel
+std::vector<std::pair<std::string, ChannelTraffic>> WebSocketClient::trafficStats() const
+{
+    std::vector<std::pair<std::string, ChannelTraffic>> stats;
+    for (size_t slot = 0; slot < traffic_.size(); ++slot)
+    {
+        if (traffic_[slot].messages > 0)
+            stats.emplace_back(dispatcher_.channelName(slot), traffic_[slot]);
+    }
+    if (other_traffic_.messages > 0)
+        stats.emplace_back("(other)", other_traffic_);
+    return stats;
+}
+
+// Function to print wire versus inflated bytes and decode cost per channel
+void WebSocketClient::printTrafficStats() const
+{
+    std::cout << "---- Traffic (deflate " << (compression_.client_enable ? "on" : "off") << ") ----\n";
+    for (const auto &[channel, traffic] : trafficStats())
+    {
+        double ratio = traffic.inflated_bytes ? static_cast<double>(traffic.wire_bytes) / traffic.inflated_bytes : 0.0;
+        std::cout << channel << ": " << traffic.messages << " msgs, "
+                  << traffic.wire_bytes << " wire B, " << traffic.inflated_bytes << " inflated B (ratio " << ratio << "), "
+                  << "decode avg " << traffic.decode_ns_total / 1e3 / traffic.messages << " us, "
+                  << "max " << traffic.decode_ns_max / 1e3 << " us\n";
+    }
+    std::cout << "-------------------------------" << std::endl;
+}
+
 // Function to close the WebSocket connection
 void WebSocketClient::close()
 {
@@ -109,27 +235,71 @@ void WebSocketClient::listen()
 {
     try
     {
+        auto last_sync = steady_clock::now(); // Time of the last clock resynchronisation
+        auto last_stats = steady_clock::now(); // Time of the last traffic report
+
         while (true) // Infinite loop to keep listening for messages
         {
             beast::flat_buffer buffer; // Buffer to store incoming messages
+            uint64_t wire_before = ws.next_layer().bytesRead();
+            int64_t read_start_ns = ClockSync::monotonicNowNs();
             ws.read(buffer); // Read data from the WebSocket into the buffer
+            int64_t read_end_ns = ClockSync::monotonicNowNs();
+            int64_t recv_ns = clock_.localNowNs(); // Receive time on the monotonic clock
+
+            // Time spent inflating and processing after the last wire bytes arrived
+            int64_t decode_ns = read_end_ns - std::max(read_start_ns, ws.next_layer().lastReadNs());
+            uint64_t wire_bytes = ws.next_layer().bytesRead() - wire_before;
 
             // Convert buffer data to a string
             auto data = beast::buffers_to_string(buffer.data());
             json response = json::parse(data); // Parse the string into a JSON object
 
-            // Check if the response contains timestamp data for latency measurement
-            if (response.contains("params") && response["params"].contains("data") &&
-                response["params"]["data"].contains("timestamp"))
+            // Periodically resample the server clock so drift stays tracked
+            if (pending_time_id_ == 0 && steady_clock::now() - last_sync >= kResyncInterval)
+            {
+                pending_time_id_ = sendTimeRequest();
+                last_sync = steady_clock::now();
+            }
+
+            // Responses to our own get_time requests feed the clock estimator
+            if (pending_time_id_ != 0 && response.value("id", 0) == pending_time_id_)
+            {
+                if (response.contains("result") && response["result"].is_number_integer())
+                {
+                    clock_.addSample(pending_time_send_ns_, response["result"].get<int64_t>(), recv_ns);
+                }
+                pending_time_id_ = 0;
+                continue;
+            }
+
+            // Print the per-channel traffic report periodically
+            if (steady_clock::now() - last_stats >= kStatsInterval)
             {
-                auto server_time = response["params"]["data"]["timestamp"].get<long long>();
-                auto client_time = duration_cast<milliseconds>(
-                                       system_clock::now().time_since_epoch())
-                                       .count();
-
-                // Calculate the time delay between the server and client
-                auto propagation_delay = client_time - server_time;
-                std::cout << "Propagation delay: " << propagation_delay << " ms" << std::endl;
+                printTrafficStats();
+                last_stats = steady_clock::now();
+            }
+
+            // Route subscription notifications to their typed handlers
+            auto routed = dispatcher_.dispatch(response);
+
+            // Account the frame to its channel
+            if (routed && traffic_.size() <= routed->slot)
+                traffic_.resize(dispatcher_.slotCount());
+            ChannelTraffic &traffic = routed ? traffic_[routed->slot] : other_traffic_;
+            traffic.messages++;
+            traffic.wire_bytes += wire_bytes;
+            traffic.inflated_bytes += buffer.size();
+            traffic.decode_ns_total += decode_ns;
+            traffic.decode_ns_max = std::max(traffic.decode_ns_max, decode_ns);
+
+            if (routed)
+            {
+                // Calculate the time delay between the server and client, corrected for clock offset
+                auto propagation_delay = clock_.oneWayDelayNs(routed->timestamp, recv_ns);
+                std::cout << "Propagation delay: " << propagation_delay / 1e6 << " ms"
+                          << " (decode " << decode_ns / 1e3 << " us)" << std::endl;
+                continue;
             }
 
             // Lock the mutex to prevent data race conditions while printing
@@ -143,14 +313,50 @@ void WebSocketClient::listen()
     }
 }
 
+// Read an integer in [low, high], prompting again on invalid input; returns fallback at end of input
+static int readIntInRange(int low, int high, int fallback)
+{
+    int value;
+    while (!(std::cin >> value) || value < low || value > high)
+    {
+        if (std::cin.eof())
+            return fallback;
+        std::cin.clear();
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        std::cout << "Please enter a number between " << low << " and " << high << ":\n";
+    }
+    return value;
+}
+
 // Function to start a WebSocket session and subscribe to market data
 void startWebSocketSession(std::string &token)
 {
     WebSocketClient wsClient; // Create an instance of WebSocketClient
 
+    // Prompt the user for the compression settings to negotiate
+    std::cout << "Enable permessage-deflate compression? (y/n)\n";
+    char compress;
+    std::cin >> compress;
+    if (compress == 'y' || compress == 'Y')
+    {
+        websocket::permessage_deflate options;
+        options.client_enable = true;
+        std::cout << "Enter the max window bits (9-15, larger compresses better but uses more memory):\n";
+        options.server_max_window_bits = readIntInRange(9, 15, 15);
+        options.client_max_window_bits = options.server_max_window_bits;
+        std::cout << "Enter the memory level (1-9):\n";
+        options.memLevel = readIntInRange(1, 9, 8);
+        wsClient.setCompression(options);
+    }
+
     // Connect to Deribit's test WebSocket server on port 443 (SSL secured)
     wsClient.connect("test.deribit.com", "443");
 
+    // Estimate the server clock offset over REST and WebSocket before streaming
+    DeribitClient restClient;
+    wsClient.clockSync().sampleRest(restClient, 4);
+    wsClient.syncClock(8);
+
     // Prompt the user for the instrument (symbol) they want to subscribe to
     std::cout << "Enter the instrument/symbol (e.g., BTC-PERPETUAL) you want to subscribe:\n";
     std::string symbol;
@@ -161,17 +367,35 @@ void startWebSocketSession(std::string &token)
     int intervalChoice;
     std::cin >> intervalChoice;
 
-    // Construct the subscription string based on the chosen interval
-    std::string subscription = "book." + symbol;
+    // Construct the subscription strings based on the chosen interval
+    std::string interval;
     if (intervalChoice == 1)
-        subscription += ".100ms";
+        interval = ".100ms";
     else if (intervalChoice == 2)
-        subscription += ".raw";
+        interval = ".raw";
     else
-        subscription += ".agg2";
+        interval = ".agg2";
+    std::string subscription = "book." + symbol + interval;
 
-    // Subscribe to the constructed channel using the provided token
-    wsClient.subscribe(subscription, token);
+    // Everything received is kept on disk for later analysis; a background thread writes
+    // buffered rows at least every TickStore::kDefaultFlushInterval so a killed session loses little
+    TickStore store("ticks");
+
+    // Subscribe to the constructed channels using the provided token
+    auto printBook = [&store](const BookUpdate &update)
+    {
+        store.appendBook(update);
+        std::cout << "Book " << update.instrument_name << " change_id " << update.change_id
+                  << " (" << update.bids.size() << " bids, " << update.asks.size() << " asks)\n";
+        for (const PriceLevel &level : update.bids)
+            std::cout << "  bid " << level.price << " x " << level.amount << "\n";
+        for (const PriceLevel &level : update.asks)
+            std::cout << "  ask " << level.price << " x " << level.amount << "\n";
+    };
+    wsClient.subscribe<BookUpdate>(subscription, token, printBook);
+    wsClient.subscribe<TradesUpdate>("trades." + symbol + interval, token,
+                                     [&store](const TradesUpdate &update)
+                                     { store.appendTrades(update); });
 
     // Start a separate thread to continuously listen for WebSocket updates
     std::thread listener([&wsClient]()
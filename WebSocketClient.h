@@ -7,6 +7,8 @@
 #include <thread>        // Thread support for multi-threading
 #include <mutex>         // Mutex for thread synchronization
 #include <chrono>        // Time-related functionalities
+#include <vector>        // Multi-channel subscriptions
+#include <utility>       // std::pair for traffic reports
 
 // Boost headers for networking, SSL, and WebSocket communication
 #include <boost/beast/core.hpp>         // Core functionalities of Boost.Beast
@@ -20,6 +22,9 @@
 #include <boost/asio/ip/tcp.hpp>        // TCP protocol handling
 #include <boost/beast/websocket.hpp>    // WebSocket support
 #include <boost/asio/ssl/stream.hpp>    // SSL stream for encrypted communication
+#include "ClockSync.h"                  // Server clock offset and drift estimation
+#include "ChannelDispatcher.h"          // Typed channel decoding and dispatch
+#include "MeteredStream.h"              // Wire byte and read-completion accounting
 
 // Namespace aliases to simplify usage of Boost libraries
 namespace beast = boost::beast;
@@ -33,7 +38,18 @@ using tcp = boost::asio::ip::tcp;
 
 // Define aliases for SSL and WebSocket streams
 using ssl_stream = boost::asio::ssl::stream<boost::asio::ip::tcp::socket>;
-using websocket_stream = boost::beast::websocket::stream<ssl_stream>;
+using websocket_stream = boost::beast::websocket::stream<MeteredStream<ssl_stream>>;
+
+/**
+ * @brief Traffic and decode-cost counters for one channel.
+ */
+struct ChannelTraffic {
+    uint64_t messages = 0;        ///< Messages received
+    uint64_t wire_bytes = 0;      ///< WebSocket frame bytes read from TLS (compressed when deflate is on)
+    uint64_t inflated_bytes = 0;  ///< Message payload bytes after inflation
+    int64_t decode_ns_total = 0;  ///< Time spent in the WebSocket read after the last wire bytes arrived
+    int64_t decode_ns_max = 0;    ///< Largest single decode time
+};
 
 /**
  * @class WebSocketClient
@@ -60,6 +76,13 @@ public:
      */
     void connect(const std::string& host, const std::string& port);
 
+    /**
+     * @brief Sets the permessage-deflate options offered in the next connect().
+     * Compression is off unless `client_enable` is set; the server decides whether to accept.
+     * @param options Window bits, memory level and context takeover settings to negotiate.
+     */
+    void setCompression(const websocket::permessage_deflate& options);
+
     /**
      * @brief Subscribes to a specific WebSocket channel.
      * @param subscription The channel name (e.g., market data feed).
@@ -67,6 +90,72 @@ public:
      */
     void subscribe(const std::string& subscription, const std::string& accessToken);
 
+    /**
+     * @brief Subscribes to several channels with a single request.
+     * @param subscriptions The channel names.
+     * @param accessToken The authentication token required for private subscriptions.
+     */
+    void subscribe(const std::vector<std::string>& subscriptions, const std::string& accessToken);
+
+    /**
+     * @brief Subscribes to a channel and routes its notifications to a typed handler.
+     * The decoder is selected here, once, from the message type.
+     * @tparam Msg The message type of the channel family (e.g. BookUpdate for `book.*`).
+     * @param subscription The channel name.
+     * @param accessToken The authentication token required for private subscriptions.
+     * @param handler Invoked from listen() with each decoded message.
+     */
+    template <typename Msg>
+    void subscribe(const std::string& subscription, const std::string& accessToken,
+                   std::function<void(const Msg&)> handler)
+    {
+        dispatcher_.on<Msg>(subscription, std::move(handler));
+        subscribe(subscription, accessToken);
+    }
+
+    /**
+     * @brief Subscribes to several channels of one family, routing them to one typed handler.
+     * @tparam Msg The message type of the channel family.
+     * @param subscriptions The channel names.
+     * @param accessToken The authentication token required for private subscriptions.
+     * @param handler Invoked from listen() with each decoded message.
+     */
+    template <typename Msg>
+    void subscribe(const std::vector<std::string>& subscriptions, const std::string& accessToken,
+                   std::function<void(const Msg&)> handler)
+    {
+        for (const std::string& subscription : subscriptions)
+            dispatcher_.on<Msg>(subscription, handler);
+        subscribe(subscriptions, accessToken);
+    }
+
+    /**
+     * @brief Samples the server clock over the WebSocket using `public/get_time`.
+     * Must be called before listen(), while no subscription traffic is expected.
+     * @param count Number of round trips to perform.
+     * @return The number of samples that were recorded successfully.
+     */
+    int syncClock(int count);
+
+    /**
+     * @brief Gives access to the clock offset estimator.
+     * Can be used to feed additional samples (e.g. over REST) before listening.
+     */
+    ClockSync& clockSync();
+
+    /**
+     * @brief Returns the traffic counters of every channel that received messages.
+     * Frames that are not routed to a channel are reported under "(other)". Wire bytes are
+     * attributed to the message whose read consumed them, so they are exact in total and
+     * approximate per message when the transport reads ahead.
+     */
+    std::vector<std::pair<std::string, ChannelTraffic>> trafficStats() const;
+
+    /**
+     * @brief Prints the traffic counters with compression ratio and average decode time.
+     */
+    void printTrafficStats() const;
+
     /**
      * @brief Listens for incoming messages from the WebSocket server.
      * Continuously reads messages and processes them in a separate thread.
@@ -84,6 +173,26 @@ private:
     tcp::resolver resolver;             ///< Resolves domain names to IP addresses
     websocket_stream ws;                ///< WebSocket stream for communication
     std::mutex mutex_;                   ///< Mutex for synchronizing output and shared resources
+    ClockSync clock_;                   ///< Local-to-server clock offset estimator
+    ChannelDispatcher dispatcher_;      ///< Channel-to-typed-handler routing
+    websocket::permessage_deflate compression_; ///< Compression options offered at handshake
+    std::vector<ChannelTraffic> traffic_; ///< Traffic per dispatcher slot
+    ChannelTraffic other_traffic_;      ///< Traffic of frames not routed to a channel
+    int next_id_ = 1;                   ///< Next JSON-RPC request id
+    int pending_time_id_ = 0;           ///< Id of the in-flight periodic get_time request, or 0
+    int64_t pending_time_send_ns_ = 0;  ///< Local send time of the in-flight get_time request
+
+    /// Interval between clock resynchronisations performed while listening.
+    static constexpr std::chrono::seconds kResyncInterval{30};
+
+    /// Interval between traffic reports printed while listening.
+    static constexpr std::chrono::seconds kStatsInterval{10};
+
+    /**
+     * @brief Sends a `public/get_time` request.
+     * @return The JSON-RPC id assigned to the request.
+     */
+    int sendTimeRequest();
 };
 
 /**
@@ -4,6 +4,7 @@
 #include <thread>         // Threading support
 #include <nlohmann/json.hpp>  // JSON handling library
 #include "WebSocketClient.h" // WebSocket client for real-time data
+#include "OptionsChain.h"    // Options chain greeks and implied volatility
 #include "Utils.h"           // Utility functions
 
 // Use JSON namespace for convenience
@@ -158,6 +159,13 @@ int main()
             webSocketThread.join(); // Wait for WebSocket thread to complete
             break;
         }
+        case 10:
+        {
+            // Start options chain session in a separate thread
+            std::thread optionsThread(startOptionsChainSession, std::ref(accessToken));
+            optionsThread.join(); // Wait for options thread to complete
+            break;
+        }
         }
     } while (ch != 9); // Continue execution until user chooses to exit
 